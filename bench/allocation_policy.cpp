@@ -0,0 +1,61 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/allocation_policy.hpp>
+#include <ptl/string.hpp>
+#include <ptl/vector.hpp>
+
+namespace {
+	constexpr std::size_t count{1'000};
+	const std::string_view text{"a string exceeding the SSO buffer"};
+
+	auto make_strings() -> std::size_t {
+		std::size_t size{0};
+		for(std::size_t i{0}; i < count; ++i) {
+			ptl::string str{text};
+			size += str.size();
+		}
+		return size;
+	}
+
+	template<typename Policy>
+	auto make_strings(Policy & policy) -> std::size_t {
+		std::size_t size{0};
+		for(std::size_t i{0}; i < count; ++i) {
+			ptl::string str{policy, text.size()};
+			str = text;
+			size += str.size();
+		}
+		return size;
+	}
+}
+
+TEST_CASE("allocation_policy short-lived strings", "[allocation_policy]") {
+	BENCHMARK("global heap") { return make_strings(); };
+	BENCHMARK_ADVANCED("ptl::arena_policy")(Catch::Benchmark::Chronometer meter) {
+		meter.measure([] {
+			ptl::arena_policy arena;
+			return make_strings(arena);
+		});
+	};
+	ptl::pool_policy pool{128};
+	BENCHMARK("ptl::pool_policy") { return make_strings(pool); };
+}
+
+TEST_CASE("allocation_policy vector push_back", "[allocation_policy]") {
+	BENCHMARK("global heap") {
+		ptl::vector<int> vec;
+		for(std::size_t i{0}; i < count; ++i) vec.push_back(static_cast<int>(i));
+		return vec.size();
+	};
+	BENCHMARK("ptl::arena_policy") {
+		ptl::arena_policy arena;
+		ptl::vector<int> vec{arena};
+		for(std::size_t i{0}; i < count; ++i) vec.push_back(static_cast<int>(i));
+		return vec.size();
+	};
+}
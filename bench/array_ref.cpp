@@ -0,0 +1,57 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <vector>
+#include <numeric>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/array_ref.hpp>
+
+namespace {
+	constexpr std::size_t count{100'000};
+
+	auto sum(ptl::array_ref<const int> values) noexcept -> long long { return std::accumulate(values.begin(), values.end(), 0LL); }
+	auto sum(const std::vector<int> & values) noexcept -> long long { return std::accumulate(values.begin(), values.end(), 0LL); }
+	auto sum(const int * values, std::size_t size) noexcept -> long long { return std::accumulate(values, values + size, 0LL); }
+}
+
+//std::span is C++20 => compare against the equivalent C++17 idioms
+TEST_CASE("array_ref iterate", "[array_ref]") {
+	std::vector<int> values(count);
+	std::iota(values.begin(), values.end(), 0);
+
+	BENCHMARK("ptl::array_ref accumulate") { return sum(values); };
+	BENCHMARK("const std::vector & accumulate") { return sum(static_cast<const std::vector<int> &>(values)); };
+	BENCHMARK("pointer + size accumulate") { return sum(values.data(), values.size()); };
+
+	BENCHMARK("ptl::array_ref operator[]") {
+		const ptl::array_ref<const int> ref{values};
+		long long result{0};
+		for(std::size_t i{0}; i < ref.size(); ++i) result += ref[i];
+		return result;
+	};
+	BENCHMARK("std::vector operator[]") {
+		long long result{0};
+		for(std::size_t i{0}; i < values.size(); ++i) result += values[i];
+		return result;
+	};
+}
+
+TEST_CASE("array_ref subrange", "[array_ref]") {
+	std::vector<int> values(count);
+	std::iota(values.begin(), values.end(), 0);
+
+	BENCHMARK("ptl::array_ref subrange") {
+		const ptl::array_ref<const int> ref{values};
+		long long result{0};
+		for(std::size_t i{0}; i + 16 <= ref.size(); i += 16) result += sum(ref.subrange(i, 16));
+		return result;
+	};
+	BENCHMARK("pointer + size subrange") {
+		long long result{0};
+		for(std::size_t i{0}; i + 16 <= values.size(); i += 16) result += sum(values.data() + i, 16);
+		return result;
+	};
+}
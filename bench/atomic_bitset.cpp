@@ -0,0 +1,100 @@
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/atomic_bitset.hpp>
+
+namespace {
+	constexpr std::size_t slots{4096}, operations{10'000}; //operations per thread
+
+	//the workers are started once and then wait for the next round, so only the claiming and releasing is measured
+	template<typename Pool>
+	class team final {
+		static
+		constexpr
+		std::size_t stop{std::numeric_limits<std::size_t>::max()};
+
+		std::atomic<std::size_t> round{0}, finished{0};
+		std::vector<std::thread> workers;
+	public:
+		team(Pool & pool, std::size_t threads) {
+			for(std::size_t t{0}; t < threads; ++t)
+				workers.emplace_back([&, t] {
+					for(std::size_t seen{0};;) {
+						std::size_t current;
+						while((current = round.load(std::memory_order_acquire)) == seen) std::this_thread::yield();
+						if(current == stop) return;
+						seen = current;
+						for(std::size_t i{0}; i < operations; ++i) pool.release(pool.claim(t));
+						finished.fetch_add(1, std::memory_order_release);
+					}
+				});
+		}
+		team(const team &) =delete;
+		auto operator=(const team &) -> team & =delete;
+		~team() noexcept {
+			round.store(stop, std::memory_order_release);
+			for(auto & worker : workers) worker.join();
+		}
+
+		void run() noexcept {
+			finished.store(0, std::memory_order_relaxed); //all workers are idle, as the previous round has completed
+			round.fetch_add(1, std::memory_order_release);
+			while(finished.load(std::memory_order_acquire) != workers.size()) std::this_thread::yield();
+		}
+	};
+
+	template<typename Pool>
+	void measure(Catch::Benchmark::Chronometer & meter, Pool & pool, std::size_t threads) {
+		team<Pool> workers{pool, threads};
+		meter.measure([&] { workers.run(); });
+	}
+
+	//free-list of a slot pool as used before: ptl::bitset protected by a mutex
+	struct locked_pool final {
+		std::mutex mutex;
+		ptl::bitset<slots> used;
+
+		auto claim(std::size_t) -> std::size_t {
+			const std::lock_guard lock{mutex};
+			const auto slot{(~used).find_first()};
+			if(slot != slots) used.set(slot);
+			return slot;
+		}
+		void release(std::size_t slot) {
+			const std::lock_guard lock{mutex};
+			used.reset(slot);
+		}
+	};
+
+	struct atomic_pool final {
+		ptl::atomic_bitset<slots> used;
+		std::size_t threads;
+
+		auto claim(std::size_t thread) noexcept -> std::size_t { return used.claim_first_zero(thread * slots / threads, std::memory_order_acquire); }
+		void release(std::size_t slot) noexcept { used.reset(slot, std::memory_order_release); }
+	};
+}
+
+//claiming and releasing slots of a pool with 4096 slots, time must not grow with the number of threads if there is no contention (requires as many cores)
+TEST_CASE("atomic_bitset contention", "[atomic_bitset]") {
+	for(const std::size_t threads : {1, 2, 4, 8, 16, 32, 64}) {
+		const auto suffix{" (" + std::to_string(threads) + " threads)"};
+		BENCHMARK_ADVANCED("ptl::bitset with std::mutex" + suffix)(Catch::Benchmark::Chronometer meter) {
+			locked_pool pool;
+			measure(meter, pool, threads);
+		};
+		BENCHMARK_ADVANCED("ptl::atomic_bitset" + suffix)(Catch::Benchmark::Chronometer meter) {
+			atomic_pool pool{{}, threads};
+			measure(meter, pool, threads);
+		};
+	}
+}
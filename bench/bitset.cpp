@@ -0,0 +1,137 @@
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <bitset>
+#include <string>
+#include <sstream>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/bitset.hpp>
+
+namespace {
+	constexpr std::size_t size{4096};
+
+	template<typename Bitset>
+	auto make_pattern(std::size_t step) -> Bitset {
+		Bitset result;
+		for(std::size_t i{0}; i < size; i += step) result.set(i);
+		return result;
+	}
+}
+
+TEST_CASE("bitset bulk operations", "[bitset]") {
+	auto sb1{make_pattern<std::bitset<size>>(3)}, sb2{make_pattern<std::bitset<size>>(7)};
+	auto pb1{make_pattern<ptl::bitset<size>>(3)}, pb2{make_pattern<ptl::bitset<size>>(7)};
+
+	BENCHMARK("ptl::bitset<4096> &=") { return pb1 &= pb2; };
+	BENCHMARK("std::bitset<4096> &=") { return sb1 &= sb2; };
+	BENCHMARK("ptl::bitset<4096> |=") { return pb1 |= pb2; };
+	BENCHMARK("std::bitset<4096> |=") { return sb1 |= sb2; };
+	BENCHMARK("ptl::bitset<4096> ^=") { return pb1 ^= pb2; };
+	BENCHMARK("std::bitset<4096> ^=") { return sb1 ^= sb2; };
+	BENCHMARK("ptl::bitset<4096> flip") { return pb1.flip(); };
+	BENCHMARK("std::bitset<4096> flip") { return sb1.flip(); };
+	BENCHMARK("ptl::bitset<4096> any") { return pb1.any(); };
+	BENCHMARK("std::bitset<4096> any") { return sb1.any(); };
+	BENCHMARK("ptl::bitset<4096> all") { return pb1.all(); };
+	BENCHMARK("std::bitset<4096> all") { return sb1.all(); };
+	BENCHMARK("ptl::bitset<4096> ==") { return pb1 == pb2; };
+	BENCHMARK("std::bitset<4096> ==") { return sb1 == sb2; };
+}
+
+namespace {
+	template<std::size_t Size>
+	void benchmark_shifting() {
+		auto pb{~ptl::bitset<Size>{}};
+		for(const auto count : {std::size_t{1}, Size / 4, Size / 2, Size - 1, Size}) {
+			const auto suffix{"<" + std::to_string(Size) + "> by " + std::to_string(count)};
+			BENCHMARK("ptl::bitset" + suffix + " <<") { return pb << count; };
+			BENCHMARK("ptl::bitset" + suffix + " >>") { return pb >> count; };
+		}
+	}
+}
+
+//time per shift must not depend on the shift amount
+TEST_CASE("bitset shifting", "[bitset]") {
+	benchmark_shifting<8>();
+	benchmark_shifting<64>();
+	benchmark_shifting<1000>();
+	benchmark_shifting<65536>();
+}
+
+namespace {
+	constexpr std::size_t slots{65536};
+
+	//free-slot map with only the last slot free
+	template<typename Bitset>
+	auto make_free_slots() -> Bitset {
+		Bitset result;
+		result.set(slots - 1);
+		return result;
+	}
+}
+
+TEST_CASE("bitset searching", "[bitset]") {
+	const auto sb{make_free_slots<std::bitset<slots>>()};
+	const auto pb{make_free_slots<ptl::bitset<slots>>()};
+
+	BENCHMARK("ptl::bitset<65536> count") { return pb.count(); };
+	BENCHMARK("std::bitset<65536> count") { return sb.count(); };
+	BENCHMARK("ptl::bitset<65536> find_first") { return pb.find_first(); };
+	BENCHMARK("ptl::bitset<65536> operator[] scan") {
+		std::size_t i{0};
+		while(i < slots && !pb[i]) ++i;
+		return i;
+	};
+	BENCHMARK("std::bitset<65536> operator[] scan") {
+		std::size_t i{0};
+		while(i < slots && !sb[i]) ++i;
+		return i;
+	};
+
+	const auto dense{~ptl::bitset<4096>{} >> 2048};
+	BENCHMARK("ptl::bitset<4096> set_bits (2048 set)") {
+		std::size_t sum{0};
+		for(auto index : dense.set_bits()) sum += index;
+		return sum;
+	};
+}
+
+//loading a large mask from configuration text
+TEST_CASE("bitset text conversion", "[bitset]") {
+	const auto sb{make_free_slots<std::bitset<slots>>()};
+	const auto pb{make_free_slots<ptl::bitset<slots>>()};
+	const auto text{sb.to_string()};
+	std::string buffer(slots, '0');
+
+	BENCHMARK("ptl::bitset<65536> operator<<") {
+		std::ostringstream os;
+		os << pb;
+		return os.str().size();
+	};
+	BENCHMARK("std::bitset<65536> operator<<") {
+		std::ostringstream os;
+		os << sb;
+		return os.str().size();
+	};
+	BENCHMARK("ptl::bitset<65536> operator>>") {
+		std::istringstream is{text};
+		ptl::bitset<slots> result;
+		is >> result;
+		return result.count();
+	};
+	BENCHMARK("std::bitset<65536> operator>>") {
+		std::istringstream is{text};
+		std::bitset<slots> result;
+		is >> result;
+		return result.count();
+	};
+	BENCHMARK("ptl::bitset<65536> to_chars") { return pb.to_chars(buffer.data(), buffer.data() + buffer.size()).ptr; };
+	BENCHMARK("ptl::bitset<65536> from_chars") {
+		ptl::bitset<slots> result;
+		result.from_chars(text.data(), text.data() + text.size());
+		return result.count();
+	};
+	BENCHMARK("ptl::bitset<65536> to_chars (hex)") { return pb.to_chars(buffer.data(), buffer.data() + buffer.size(), 16).ptr; };
+}
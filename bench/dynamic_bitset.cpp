@@ -0,0 +1,95 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/dynamic_bitset.hpp>
+
+namespace {
+	constexpr std::size_t size{65536};
+
+	template<typename Bitset>
+	auto make_random(unsigned seed) -> Bitset {
+		std::mt19937_64 engine{seed};
+		Bitset result(size);
+		for(std::size_t i{0}; i < size; ++i)
+			if(engine() % 16 == 0)
+				result[i] = true;
+		return result;
+	}
+}
+
+TEST_CASE("dynamic_bitset construction", "[dynamic_bitset]") {
+	BENCHMARK("ptl::dynamic_bitset push_back") {
+		ptl::dynamic_bitset db;
+		for(std::size_t i{0}; i < size; ++i) db.push_back(i % 3 == 0);
+		return db;
+	};
+	BENCHMARK("std::vector<bool> push_back") {
+		std::vector<bool> vb;
+		for(std::size_t i{0}; i < size; ++i) vb.push_back(i % 3 == 0);
+		return vb;
+	};
+	BENCHMARK("ptl::dynamic_bitset resize") {
+		ptl::dynamic_bitset db;
+		for(std::size_t i{1}; i <= 64; ++i) db.resize(i * 1024, i % 2 == 0);
+		return db;
+	};
+	BENCHMARK("std::vector<bool> resize") {
+		std::vector<bool> vb;
+		for(std::size_t i{1}; i <= 64; ++i) vb.resize(i * 1024, i % 2 == 0);
+		return vb;
+	};
+}
+
+TEST_CASE("dynamic_bitset queries", "[dynamic_bitset]") {
+	const auto db{make_random<ptl::dynamic_bitset>(1)};
+	const auto vb{make_random<std::vector<bool>>(1)};
+
+	BENCHMARK("ptl::dynamic_bitset count") { return db.count(); };
+	BENCHMARK("std::vector<bool> count") { return std::count(vb.begin(), vb.end(), true); };
+	BENCHMARK("ptl::dynamic_bitset set_bits") {
+		std::size_t sum{0};
+		for(const auto index : db.set_bits()) sum += index;
+		return sum;
+	};
+	BENCHMARK("std::vector<bool> scan") {
+		std::size_t sum{0};
+		for(std::size_t i{0}; i < vb.size(); ++i)
+			if(vb[i])
+				sum += i;
+		return sum;
+	};
+	BENCHMARK("ptl::dynamic_bitset operator[] scan") {
+		std::size_t sum{0};
+		for(std::size_t i{0}; i < db.size(); ++i)
+			if(db[i])
+				sum += i;
+		return sum;
+	};
+}
+
+TEST_CASE("dynamic_bitset bitwise", "[dynamic_bitset]") {
+	auto db1{make_random<ptl::dynamic_bitset>(1)};
+	const auto db2{make_random<ptl::dynamic_bitset>(2)};
+	auto vb1{make_random<std::vector<bool>>(1)};
+	const auto vb2{make_random<std::vector<bool>>(2)};
+
+	BENCHMARK("ptl::dynamic_bitset |=") { return db1 |= db2; };
+	BENCHMARK("std::vector<bool> |=") {
+		for(std::size_t i{0}; i < size; ++i)
+			if(vb2[i])
+				vb1[i] = true;
+		return vb1.size();
+	};
+	BENCHMARK("ptl::dynamic_bitset flip") { return db1.flip(); };
+	BENCHMARK("std::vector<bool> flip") {
+		vb1.flip();
+		return vb1.size();
+	};
+}
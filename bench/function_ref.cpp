@@ -0,0 +1,54 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <vector>
+#include <functional>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/function_ref.hpp>
+
+namespace {
+	constexpr std::size_t count{1'000};
+
+	auto twice(int value) noexcept -> int { return value * 2; }
+}
+
+TEST_CASE("function_ref invoke", "[function_ref]") {
+	int offset{3};
+	const auto add{[&](int value) noexcept { return value + offset; }};
+
+	//alternating targets prevent the compiler from devirtualizing the calls
+	std::vector<ptl::function_ref<int(int) noexcept>> pf;
+	std::vector<std::function<int(int)>> sf;
+	for(std::size_t i{0}; i < count; ++i) {
+		if(i % 2) {
+			pf.emplace_back(add);
+			sf.emplace_back(add);
+		} else {
+			pf.emplace_back(twice);
+			sf.emplace_back(twice);
+		}
+	}
+
+	BENCHMARK("ptl::function_ref invoke") {
+		int sum{0};
+		for(std::size_t i{0}; i < count; ++i) sum += pf[i](static_cast<int>(i));
+		return sum;
+	};
+	BENCHMARK("std::function invoke") {
+		int sum{0};
+		for(std::size_t i{0}; i < count; ++i) sum += sf[i](static_cast<int>(i));
+		return sum;
+	};
+}
+
+TEST_CASE("function_ref construct", "[function_ref]") {
+	int offset{3};
+	auto big{[offset, padding = std::array<int, 8>{}](int value) noexcept { return value + offset + padding[0]; }}; //exceeds the small buffer of std::function
+
+	BENCHMARK("ptl::function_ref construct") { return ptl::function_ref<int(int) noexcept>{big}(1); };
+	BENCHMARK("std::function construct") { return std::function<int(int)>{big}(1); };
+}
@@ -0,0 +1,47 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <vector>
+#include <string_view>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/hash.hpp>
+#include <ptl/bitset.hpp>
+#include <ptl/string.hpp>
+
+namespace {
+	//byte-wise algorithm previously used by std::hash<ptl::bitset>
+	auto fnv1a(const unsigned char * ptr, std::size_t size) noexcept -> std::uint64_t {
+		std::uint64_t hash{14695981039346656037ULL};
+		for(std::size_t i{0}; i < size; ++i) {
+			hash ^= ptr[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+}
+
+TEST_CASE("hash bytes", "[hash]") {
+	std::vector<unsigned char> bytes(1 << 20);
+	for(std::size_t i{0}; i < bytes.size(); ++i) bytes[i] = static_cast<unsigned char>(i * 37 + 11);
+
+	for(const std::size_t size : {8, 64, 512, 4096, 1 << 20}) {
+		const auto suffix{" " + std::to_string(size) + " bytes"};
+		BENCHMARK("ptl::hash_bytes" + suffix) { return ptl::hash_bytes(bytes.data(), size); };
+		BENCHMARK("fnv1a" + suffix) { return fnv1a(bytes.data(), size); };
+		BENCHMARK("std::hash<std::string_view>" + suffix) { return std::hash<std::string_view>{}({reinterpret_cast<const char *>(bytes.data()), size}); };
+	}
+}
+
+TEST_CASE("hash specializations", "[hash]") {
+	const auto pb{~ptl::bitset<4096>{} >> 7};
+	BENCHMARK("std::hash<ptl::bitset<4096>>") { return std::hash<ptl::bitset<4096>>{}(pb); };
+
+	const ptl::string ps(100, 'x');
+	const std::string ss(100, 'x');
+	BENCHMARK("std::hash<ptl::string> 100 chars") { return std::hash<ptl::string>{}(ps); };
+	BENCHMARK("std::hash<std::string> 100 chars") { return std::hash<std::string>{}(ss); };
+}
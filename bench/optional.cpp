@@ -0,0 +1,61 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/optional.hpp>
+
+namespace {
+	constexpr std::size_t count{10'000};
+
+	template<typename Optional>
+	auto make_optionals() -> std::vector<Optional> {
+		std::vector<Optional> result(count);
+		for(std::size_t i{0}; i < count; i += 2) result[i] = static_cast<int>(i);
+		return result;
+	}
+}
+
+TEST_CASE("optional access", "[optional]") {
+	const auto po{make_optionals<ptl::optional<int>>()};
+	const auto so{make_optionals<std::optional<int>>()};
+
+	BENCHMARK("ptl::optional value_or") {
+		long long sum{0};
+		for(const auto & o : po) sum += o.value_or(-1);
+		return sum;
+	};
+	BENCHMARK("std::optional value_or") {
+		long long sum{0};
+		for(const auto & o : so) sum += o.value_or(-1);
+		return sum;
+	};
+	BENCHMARK("ptl::optional has_value + operator*") {
+		long long sum{0};
+		for(const auto & o : po) if(o) sum += *o;
+		return sum;
+	};
+	BENCHMARK("std::optional has_value + operator*") {
+		long long sum{0};
+		for(const auto & o : so) if(o) sum += *o;
+		return sum;
+	};
+}
+
+TEST_CASE("optional copy", "[optional]") {
+	const auto po{make_optionals<ptl::optional<int>>()};
+	const auto so{make_optionals<std::optional<int>>()};
+
+	BENCHMARK("ptl::optional<int> copy") { return std::vector<ptl::optional<int>>{po}; };
+	BENCHMARK("std::optional<int> copy") { return std::vector<std::optional<int>>{so}; };
+
+	const ptl::optional<std::string> ps{"a string exceeding the SSO buffer"};
+	const std::optional<std::string> ss{"a string exceeding the SSO buffer"};
+	BENCHMARK("ptl::optional<std::string> copy") { return ptl::optional<std::string>{ps}; };
+	BENCHMARK("std::optional<std::string> copy") { return std::optional<std::string>{ss}; };
+}
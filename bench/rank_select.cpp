@@ -0,0 +1,63 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/rank_select.hpp>
+
+namespace {
+	constexpr std::size_t queries{1000};
+
+	auto make_presence_map(std::size_t size) -> ptl::dynamic_bitset {
+		std::mt19937_64 engine{42};
+		ptl::dynamic_bitset result(size);
+		for(std::size_t i{0}; i < size; ++i)
+			if(engine() % 4 == 0)
+				result.set(i);
+		return result;
+	}
+
+	auto make_queries(std::size_t limit) -> std::vector<std::size_t> {
+		std::mt19937_64 engine{7};
+		std::vector<std::size_t> result(queries);
+		for(auto & query : result) query = static_cast<std::size_t>(engine() % limit);
+		return result;
+	}
+}
+
+//throughput of 1000 random queries
+TEST_CASE("rank_select queries", "[rank_select]") {
+	for(const std::size_t size : {std::size_t{1} << 20, std::size_t{100'000'000}}) {
+		const auto bits{make_presence_map(size)};
+		const auto suffix{" (" + std::to_string(size) + " bits)"};
+
+		BENCHMARK("ptl::rank_select build" + suffix) { return ptl::rank_select{bits}.count(); };
+
+		const ptl::rank_select index{bits};
+		WARN("index overhead" << suffix << ": " << 100.0 * static_cast<double>(index.memory_usage()) * 8 / static_cast<double>(size) << "%");
+		const auto positions{make_queries(size)};
+		const auto ranks{make_queries(index.count())};
+
+		BENCHMARK("ptl::rank_select rank" + suffix) {
+			std::size_t sum{0};
+			for(const auto position : positions) sum += index.rank(position);
+			return sum;
+		};
+		BENCHMARK("ptl::rank_select select" + suffix) {
+			std::size_t sum{0};
+			for(const auto rank : ranks) sum += index.select(rank);
+			return sum;
+		};
+		if(size > (std::size_t{1} << 20)) continue;
+		BENCHMARK("ptl::dynamic_bitset count on shifted copy" + suffix) {
+			std::size_t sum{0};
+			for(const auto position : positions) sum += (bits << (size - position)).count();
+			return sum;
+		};
+	}
+}
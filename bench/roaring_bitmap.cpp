@@ -0,0 +1,66 @@
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <random>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/roaring_bitmap.hpp>
+
+namespace {
+	//about 0.1% of all 32-bit values
+	auto make_values(std::uint32_t seed) -> std::vector<std::uint32_t> {
+		std::mt19937 engine{seed};
+		std::vector<std::uint32_t> result(4'300'000);
+		for(auto & value : result) value = static_cast<std::uint32_t>(engine());
+		std::sort(result.begin(), result.end());
+		result.erase(std::unique(result.begin(), result.end()), result.end());
+		return result;
+	}
+
+	auto make_bitmap(const std::vector<std::uint32_t> & values) -> ptl::roaring_bitmap {
+		ptl::roaring_bitmap result;
+		for(const auto value : values) result.add(value);
+		result.optimize();
+		return result;
+	}
+}
+
+TEST_CASE("roaring_bitmap set operations", "[roaring_bitmap]") {
+	const auto lhs{make_values(1)}, rhs{make_values(2)};
+	const auto rb_lhs{make_bitmap(lhs)}, rb_rhs{make_bitmap(rhs)};
+	WARN("memory: ptl::roaring_bitmap " << rb_lhs.memory_usage() << " bytes, sorted std::vector " << lhs.size() * sizeof(std::uint32_t) << " bytes");
+
+	BENCHMARK("sorted std::vector intersection") {
+		std::vector<std::uint32_t> result;
+		std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+		return result.size();
+	};
+	BENCHMARK("ptl::roaring_bitmap intersection") { return (rb_lhs & rb_rhs).cardinality(); };
+
+	BENCHMARK("sorted std::vector union") {
+		std::vector<std::uint32_t> result;
+		std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+		return result.size();
+	};
+	BENCHMARK("ptl::roaring_bitmap union") { return (rb_lhs | rb_rhs).cardinality(); };
+
+	BENCHMARK("sorted std::vector difference") {
+		std::vector<std::uint32_t> result;
+		std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+		return result.size();
+	};
+	BENCHMARK("ptl::roaring_bitmap difference") { return (rb_lhs - rb_rhs).cardinality(); };
+
+	BENCHMARK("sorted std::vector cardinality") { return lhs.size(); };
+	BENCHMARK("ptl::roaring_bitmap cardinality") { return rb_lhs.cardinality(); };
+
+	const auto bytes{rb_lhs.serialize()}, other_bytes{rb_rhs.serialize()};
+	const ptl::roaring_view view{bytes.data(), bytes.size()}, other{other_bytes.data(), other_bytes.size()};
+	BENCHMARK("ptl::roaring_bitmap deserialization") { return ptl::roaring_bitmap{ptl::roaring_view{bytes.data(), bytes.size()}}.cardinality(); };
+	BENCHMARK("ptl::roaring_view open") { return ptl::roaring_view{bytes.data(), bytes.size()}.cardinality(); };
+	BENCHMARK("ptl::roaring_view intersection") { return (view & other).cardinality(); };
+}
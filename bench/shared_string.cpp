@@ -0,0 +1,28 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <vector>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/shared_string.hpp>
+
+//fan out a multi-kilobyte payload to many consumers
+TEST_CASE("shared_string copy", "[shared_string]") {
+	constexpr std::size_t consumers{64};
+	const std::string payload(8 * 1024, 'p');
+	const ptl::shared_string shared{std::string_view{payload}};
+	const ptl::string owned{std::string_view{payload}};
+
+	BENCHMARK("ptl::shared_string copy") { return std::vector<ptl::shared_string>(consumers, shared); };
+	BENCHMARK("ptl::string copy") { return std::vector<ptl::string>(consumers, owned); };
+	BENCHMARK("std::string copy") { return std::vector<std::string>(consumers, payload); };
+
+	BENCHMARK("ptl::shared_string from ptl::string") {
+		ptl::string str{std::string_view{payload}};
+		return ptl::shared_string{std::move(str)};
+	};
+	BENCHMARK("ptl::shared_string from std::string_view") { return ptl::shared_string{std::string_view{payload}}; };
+}
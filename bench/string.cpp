@@ -0,0 +1,216 @@
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <vector>
+#include <random>
+#include <sstream>
+#include <algorithm>
+#include <string_view>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/string.hpp>
+
+namespace {
+	template<typename String>
+	auto push_back_chars(std::size_t count) -> String {
+		String str;
+		for(std::size_t i{0}; i < count; ++i) str.push_back(static_cast<char>('a' + i % 26));
+		return str;
+	}
+
+	template<typename String>
+	auto append_chunks(std::size_t count) -> String {
+		constexpr std::string_view chunk{"0123456789abcdef"};
+		String str;
+		for(std::size_t i{0}; i < count; i += chunk.size()) str.append(chunk);
+		return str;
+	}
+}
+
+//time per byte must remain constant across sizes (=> linear-time appends)
+TEST_CASE("string push_back", "[string]") {
+	constexpr std::size_t MB{1 << 20};
+
+	BENCHMARK("ptl::string push_back 1MB") { return push_back_chars<ptl::string>(1 * MB); };
+	BENCHMARK("std::string push_back 1MB") { return push_back_chars<std::string>(1 * MB); };
+	BENCHMARK("ptl::string push_back 10MB") { return push_back_chars<ptl::string>(10 * MB); };
+	BENCHMARK("std::string push_back 10MB") { return push_back_chars<std::string>(10 * MB); };
+	BENCHMARK("ptl::string push_back 100MB") { return push_back_chars<ptl::string>(100 * MB); };
+	BENCHMARK("std::string push_back 100MB") { return push_back_chars<std::string>(100 * MB); };
+}
+
+TEST_CASE("string append", "[string]") {
+	constexpr std::size_t MB{1 << 20};
+
+	BENCHMARK("ptl::string append 1MB") { return append_chunks<ptl::string>(1 * MB); };
+	BENCHMARK("std::string append 1MB") { return append_chunks<std::string>(1 * MB); };
+	BENCHMARK("ptl::string append 10MB") { return append_chunks<ptl::string>(10 * MB); };
+	BENCHMARK("std::string append 10MB") { return append_chunks<std::string>(10 * MB); };
+	BENCHMARK("ptl::string append 100MB") { return append_chunks<ptl::string>(100 * MB); };
+	BENCHMARK("std::string append 100MB") { return append_chunks<std::string>(100 * MB); };
+}
+
+TEST_CASE("string concatenation", "[string]") {
+	const ptl::string pkey{"tenant-42"}, psep{"::"};
+	const std::string skey{"tenant-42"}, ssep{"::"};
+	const std::string_view component{"session"}, id{"0123456789abcdef"};
+
+	BENCHMARK("ptl::string 8-way operator+") { return ptl::string{pkey + psep + component + '/' + id + psep + "suffix" + '!'}; };
+	BENCHMARK("std::string 8-way operator+") { return std::string{skey + ssep + std::string{component} + '/' + std::string{id} + ssep + "suffix" + '!'}; };
+	BENCHMARK("ptl::string 8-way operator+=") {
+		ptl::string result{pkey};
+		result += psep + component + '/' + id + psep + "suffix" + '!';
+		return result;
+	};
+}
+
+//short (SSO) and long (heap) strings interleaved randomly => unpredictable representation
+TEST_CASE("string mixed lengths", "[string]") {
+	std::mt19937 gen{42};
+	std::uniform_int_distribution<std::size_t> length{1, 44};
+	std::vector<ptl::string> pstrings;
+	std::vector<std::string> sstrings;
+	for(std::size_t i{0}; i < 100'000; ++i) {
+		const std::string str(length(gen), static_cast<char>('a' + i % 26));
+		pstrings.emplace_back(str);
+		sstrings.push_back(str);
+	}
+
+	BENCHMARK("ptl::string size") {
+		std::size_t sum{0};
+		for(const auto & str : pstrings) sum += str.size();
+		return sum;
+	};
+	BENCHMARK("std::string size") {
+		std::size_t sum{0};
+		for(const auto & str : sstrings) sum += str.size();
+		return sum;
+	};
+	BENCHMARK("ptl::string front + back") {
+		std::size_t sum{0};
+		for(const auto & str : pstrings) sum += static_cast<std::size_t>(str.front() + str.back());
+		return sum;
+	};
+	BENCHMARK("std::string front + back") {
+		std::size_t sum{0};
+		for(const auto & str : sstrings) sum += static_cast<std::size_t>(str.front() + str.back());
+		return sum;
+	};
+	BENCHMARK("ptl::string iterate") {
+		std::size_t sum{0};
+		for(const auto & str : pstrings) for(const auto ch : str) sum += static_cast<std::size_t>(ch);
+		return sum;
+	};
+	BENCHMARK("std::string iterate") {
+		std::size_t sum{0};
+		for(const auto & str : sstrings) for(const auto ch : str) sum += static_cast<std::size_t>(ch);
+		return sum;
+	};
+	BENCHMARK("ptl::string ==") { return std::count(pstrings.begin(), pstrings.end(), pstrings[42]); };
+	BENCHMARK("std::string ==") { return std::count(sstrings.begin(), sstrings.end(), sstrings[42]); };
+}
+
+namespace {
+	//character that counts how often it is written, to replay the append + std::rotate strategy used before memmove
+	struct counted_char final {
+		static
+		inline
+		std::size_t writes{0};
+
+		char value{};
+
+		counted_char() noexcept =default;
+		counted_char(char value) noexcept : value{value} {}
+		counted_char(const counted_char & other) noexcept : value{other.value} { ++writes; }
+		auto operator=(const counted_char & other) noexcept -> counted_char & {
+			value = other.value;
+			++writes;
+			return *this;
+		}
+	};
+
+	auto rotate_insert_writes(std::size_t size, std::size_t pos, std::size_t count) -> std::size_t {
+		std::vector<counted_char> buffer(size + count);
+		counted_char::writes = 0;
+		std::fill_n(buffer.begin() + static_cast<std::ptrdiff_t>(size), count, counted_char{'x'}); //append
+		std::rotate(buffer.begin() + static_cast<std::ptrdiff_t>(pos), buffer.begin() + static_cast<std::ptrdiff_t>(size), buffer.end());
+		return counted_char::writes;
+	}
+}
+
+//editing a large string in place, moved bytes: memmove touches the tail and the new characters once
+TEST_CASE("string in-place editing", "[string]") {
+	constexpr std::size_t size{4096}, pos{1024}, count{16};
+	const std::string text(size, 'a');
+	const std::string_view insertion{"0123456789abcdef"};
+	WARN("insert " << count << " characters at " << pos << " of " << size << ": bytes moved by memmove: " << (size - pos + count) << ", by append + std::rotate: " << rotate_insert_writes(size, pos, count));
+	WARN("assign the second half to itself: bytes moved by memmove: " << size / 2 << ", by append + std::rotate: " << rotate_insert_writes(size + size / 2, 0, size / 2) - size / 2 << " (+ erasing the old content)");
+
+	ptl::string pstr{std::string_view{text}};
+	pstr.reserve(2 * size);
+	std::string sstr{text};
+	sstr.reserve(2 * size);
+
+	BENCHMARK("ptl::string insert + erase") {
+		pstr.insert(pstr.cbegin() + pos, insertion);
+		return pstr.erase(pstr.cbegin() + pos, pstr.cbegin() + pos + count);
+	};
+	BENCHMARK("std::string insert + erase") {
+		sstr.insert(pos, insertion);
+		return sstr.erase(pos, count);
+	};
+	BENCHMARK("ptl::string replace growing + shrinking") {
+		pstr.replace(pstr.cbegin() + pos, pstr.cbegin() + pos + count / 2, insertion);
+		return pstr.replace(pstr.cbegin() + pos, pstr.cbegin() + pos + count, insertion.substr(0, count / 2)).size();
+	};
+	BENCHMARK("std::string replace growing + shrinking") {
+		sstr.replace(pos, count / 2, insertion);
+		return sstr.replace(pos, count, insertion.substr(0, count / 2)).size();
+	};
+	BENCHMARK("ptl::string insert self-referencing") {
+		pstr.insert(pstr.cbegin() + pos, pstr.cbegin() + pos + 100, pstr.cbegin() + pos + 100 + count);
+		return pstr.erase(pstr.cbegin() + pos, pstr.cbegin() + pos + count);
+	};
+	BENCHMARK("std::string insert self-referencing") {
+		sstr.insert(sstr.begin() + pos, sstr.begin() + pos + 100, sstr.begin() + pos + 100 + count);
+		return sstr.erase(pos, count);
+	};
+}
+
+//emitting a CSV row of telemetry values
+TEST_CASE("string number formatting", "[string]") {
+	std::vector<double> values(1000);
+	std::mt19937_64 engine{42};
+	std::uniform_real_distribution<double> dist{-1e6, 1e6};
+	for(auto & value : values) value = dist(engine);
+
+	BENCHMARK("std::ostringstream") {
+		std::ostringstream os;
+		os.precision(17);
+		for(const auto value : values) os << value << ',';
+		return os.str();
+	};
+	BENCHMARK("std::to_string") {
+		std::string str;
+		for(const auto value : values) {
+			str += std::to_string(value);
+			str += ',';
+		}
+		return str;
+	};
+	BENCHMARK("ptl::string::append_float") {
+		ptl::string str;
+		for(const auto value : values) {
+			str.append_float(value);
+			str += ',';
+		}
+		return str;
+	};
+	BENCHMARK("ptl::string::append_floats") {
+		ptl::string str;
+		str.append_floats(values);
+		return str;
+	};
+}
@@ -0,0 +1,109 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/string.hpp>
+#include <ptl/string_interner.hpp>
+
+namespace {
+	//many repetitions of few unique identifiers, as found in metric or column names
+	auto make_names() -> std::vector<std::string> {
+		std::vector<std::string> result;
+		for(std::size_t i{0}; i < 100'000; ++i) result.push_back("service.http.requests.latency_bucket_" + std::to_string(i * 7919 % 1'000));
+		return result;
+	}
+}
+
+TEST_CASE("string_interner memory", "[string_interner]") {
+	const auto names{make_names()};
+
+	ptl::string_interner interner;
+	std::vector<ptl::interned_string> handles;
+	for(const auto & name : names) handles.push_back(interner.intern(name));
+	const auto interned_bytes{handles.size() * sizeof(ptl::interned_string) + interner.memory_usage()};
+
+	std::vector<ptl::string> strings;
+	for(const auto & name : names) strings.emplace_back(name);
+	std::size_t string_bytes{strings.size() * sizeof(ptl::string)};
+	for(const auto & str : strings) string_bytes += str.capacity() + 1;
+
+	WARN("interned: " << interned_bytes << " bytes, ptl::string: " << string_bytes << " bytes");
+
+	BENCHMARK("ptl::string_interner::intern") {
+		ptl::string_interner interner;
+		for(const auto & name : names) interner.intern(name);
+		return interner.size();
+	};
+	BENCHMARK("ptl::vector<ptl::string>") {
+		std::vector<ptl::string> strings;
+		for(const auto & name : names) strings.emplace_back(name);
+		return strings.size();
+	};
+}
+
+TEST_CASE("string_interner lookup", "[string_interner]") {
+	const auto names{make_names()};
+	ptl::string_interner interner;
+	std::unordered_set<std::string> set;
+	for(const auto & name : names) {
+		interner.intern(name);
+		set.insert(name);
+	}
+
+	BENCHMARK("ptl::string_interner::intern existing") {
+		std::size_t sum{0};
+		for(const auto & name : names) sum += interner.intern(name).size();
+		return sum;
+	};
+	BENCHMARK("std::unordered_set<std::string>::find") {
+		std::size_t sum{0};
+		for(const auto & name : names) sum += set.find(name)->size();
+		return sum;
+	};
+
+	std::vector<ptl::interned_string> handles;
+	for(const auto & name : names) handles.push_back(interner.intern(name));
+	const auto needle{interner.find(names[42])};
+	std::vector<ptl::string> strings;
+	for(const auto & name : names) strings.emplace_back(name);
+	const ptl::string str_needle{names[42]};
+
+	BENCHMARK("ptl::interned_string ==") { return std::count(handles.begin(), handles.end(), needle); };
+	BENCHMARK("ptl::string ==") { return std::count(strings.begin(), strings.end(), str_needle); };
+}
+
+//time must not grow with the number of threads if shards prevent contention (requires as many cores)
+TEST_CASE("string_interner contention", "[string_interner]") {
+	const auto names{make_names()};
+	const auto run{[&](ptl::string_interner & interner, unsigned threads) {
+		std::vector<std::thread> workers;
+		for(unsigned t{0}; t < threads; ++t)
+			workers.emplace_back([&, t] {
+				for(auto i{t}; i < names.size(); i += threads) interner.intern(names[i]);
+			});
+		for(auto & worker : workers) worker.join();
+		return interner.size();
+	}};
+	const auto max_threads{std::max(std::thread::hardware_concurrency(), 1u)};
+
+	BENCHMARK("ptl::string_interner 1 thread") {
+		ptl::string_interner interner;
+		return run(interner, 1);
+	};
+	BENCHMARK("ptl::string_interner all threads") {
+		ptl::string_interner interner;
+		return run(interner, max_threads);
+	};
+	BENCHMARK("ptl::string_interner all threads, single shard") {
+		ptl::string_interner interner{1};
+		return run(interner, max_threads);
+	};
+}
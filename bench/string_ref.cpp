@@ -0,0 +1,139 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <string_view>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/string_ref.hpp>
+
+namespace {
+	auto make_words() -> std::vector<std::string> {
+		std::vector<std::string> result;
+		for(std::size_t i{0}; i < 10'000; ++i) result.push_back("prefix/" + std::to_string(i * 7919 % 10'000));
+		return result;
+	}
+}
+
+TEST_CASE("string_ref compare", "[string_ref]") {
+	const auto words{make_words()};
+	std::vector<ptl::string_ref> pr(words.begin(), words.end());
+	std::vector<std::string_view> sv(words.begin(), words.end());
+
+	BENCHMARK("ptl::string_ref sort") {
+		auto copy{pr};
+		std::sort(copy.begin(), copy.end());
+		return copy;
+	};
+	BENCHMARK("std::string_view sort") {
+		auto copy{sv};
+		std::sort(copy.begin(), copy.end());
+		return copy;
+	};
+	BENCHMARK("ptl::string_ref ==") { return std::count(pr.begin(), pr.end(), ptl::string_ref{"prefix/42"}); };
+	BENCHMARK("std::string_view ==") { return std::count(sv.begin(), sv.end(), std::string_view{"prefix/42"}); };
+}
+
+TEST_CASE("string_ref construct", "[string_ref]") {
+	const auto words{make_words()};
+	std::vector<const char *> ptrs;
+	for(const auto & word : words) ptrs.push_back(word.c_str());
+
+	BENCHMARK("ptl::string_ref from const char * + substr") {
+		std::size_t sum{0};
+		for(auto ptr : ptrs) sum += ptl::string_ref{ptr}.substr(7).size();
+		return sum;
+	};
+	BENCHMARK("std::string_view from const char * + substr") {
+		std::size_t sum{0};
+		for(auto ptr : ptrs) sum += std::string_view{ptr}.substr(7).size();
+		return sum;
+	};
+}
+
+TEST_CASE("string_ref find", "[string_ref]") {
+	std::string text;
+	for(std::size_t i{0}; i < 64; ++i) text += "Accept-Encoding: gzip, deflate\r\nUser-Agent: ptl-bench/" + std::to_string(i) + "\r\n";
+	text += "Content-Length: 42\r\n\r\n";
+	const ptl::string_ref pr{text};
+	const std::string_view sv{text};
+
+	BENCHMARK("ptl::string_ref::find(char)") { return pr.find('#'); };
+	BENCHMARK("std::string_view::find(char)") { return sv.find('#'); };
+	BENCHMARK("ptl::string_ref::find(string)") { return pr.find("\r\n\r\n"); };
+	BENCHMARK("std::string_view::find(string)") { return sv.find("\r\n\r\n"); };
+	BENCHMARK("ptl::string_ref::find(string) frequent first char") { return pr.find("Content-Length"); };
+	BENCHMARK("std::string_view::find(string) frequent first char") { return sv.find("Content-Length"); };
+	BENCHMARK("ptl::string_ref::rfind(string)") { return pr.rfind("Accept-Encoding"); };
+	BENCHMARK("std::string_view::rfind(string)") { return sv.rfind("Accept-Encoding"); };
+	BENCHMARK("ptl::string_ref::find_first_of") { return pr.find_first_of("#$%"); };
+	BENCHMARK("std::string_view::find_first_of") { return sv.find_first_of("#$%"); };
+	BENCHMARK("ptl::string_ref::find_last_not_of") { return pr.find_last_not_of("\r\nACDEGLUabcdefghilmnoprstuvz-:, /0123456789"); };
+	BENCHMARK("std::string_view::find_last_not_of") { return sv.find_last_not_of("\r\nACDEGLUabcdefghilmnoprstuvz-:, /0123456789"); };
+}
+
+TEST_CASE("string_ref split", "[string_ref]") {
+	std::string corpus; //CSV-like records, scaled down from production sizes to keep the run short
+	for(std::size_t i{0}; corpus.size() < 16 * 1024 * 1024; ++i) corpus += std::to_string(i) + ",user" + std::to_string(i * 7919 % 100'000) + ",GET,/api/v1/items/" + std::to_string(i % 977) + ",200," + std::to_string(i * 31 % 5'000) + ",Mozilla/5.0 (X11; Linux x86_64)\n";
+	const ptl::string_ref pr{corpus};
+
+	BENCHMARK("ptl::string_ref::split(char)") {
+		std::size_t count{0};
+		for(const auto piece : pr.split(',')) count += piece.size();
+		return count;
+	};
+	BENCHMARK("naive loop split(char)") {
+		std::size_t count{0};
+		for(auto first{corpus.data()}, last{first + corpus.size()};; ) {
+			auto it{first};
+			while(it != last && *it != ',') ++it;
+			count += static_cast<std::size_t>(it - first);
+			if(it == last) break;
+			first = it + 1;
+		}
+		return count;
+	};
+	BENCHMARK("std::string_view::find split(char)") {
+		std::size_t count{0};
+		for(std::string_view sv{corpus};; ) {
+			const auto pos{sv.find(',')};
+			count += std::min(pos, sv.size());
+			if(pos == std::string_view::npos) break;
+			sv.remove_prefix(pos + 1);
+		}
+		return count;
+	};
+
+	BENCHMARK("ptl::string_ref::split_any") {
+		std::size_t count{0};
+		for(const auto piece : pr.split_any(",\n")) count += piece.size();
+		return count;
+	};
+	BENCHMARK("std::string_view::find_first_of split_any") {
+		std::size_t count{0};
+		for(std::string_view sv{corpus};; ) {
+			const auto pos{sv.find_first_of(",\n")};
+			count += std::min(pos, sv.size());
+			if(pos == std::string_view::npos) break;
+			sv.remove_prefix(pos + 1);
+		}
+		return count;
+	};
+
+	BENCHMARK("ptl::string_ref::lines") {
+		std::size_t count{0};
+		for(const auto line : pr.lines()) count += line.size();
+		return count;
+	};
+	BENCHMARK("std::getline") {
+		std::size_t count{0};
+		std::istringstream is{corpus};
+		for(std::string line; std::getline(is, line); ) count += line.size();
+		return count;
+	};
+}
@@ -0,0 +1,121 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <variant>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/variant.hpp>
+
+namespace {
+	constexpr std::size_t count{10'000};
+
+	template<typename Variant>
+	auto make_variants() -> std::vector<Variant> {
+		std::vector<Variant> result;
+		result.reserve(count);
+		for(std::size_t i{0}; i < count; ++i)
+			switch(i % 3) {
+				case 0: result.emplace_back(static_cast<int>(i)); break;
+				case 1: result.emplace_back(static_cast<double>(i)); break;
+				default: result.emplace_back(static_cast<long long>(i)); break;
+			}
+		return result;
+	}
+
+	struct to_double final {
+		template<typename T>
+		auto operator()(const T & value) const noexcept -> double { return static_cast<double>(value); }
+	};
+
+	//messages of a router, handled with varying costs
+	struct ping final { std::uint32_t id; };
+	struct pong final { std::uint32_t id; };
+	struct data final { std::uint32_t id, size; };
+	struct ack final { std::uint32_t id, sequence; };
+	struct nack final { std::uint32_t id, sequence, reason; };
+	struct close final { std::uint32_t id; std::uint16_t code; };
+
+	template<typename Variant>
+	auto make_messages() -> std::vector<Variant> {
+		std::mt19937 engine{42}; //unpredictable order of messages
+		std::vector<Variant> result;
+		result.reserve(count);
+		for(std::uint32_t i{0}; i < count; ++i)
+			switch(engine() % 6) {
+				case 0: result.emplace_back(ping{i}); break;
+				case 1: result.emplace_back(pong{i}); break;
+				case 2: result.emplace_back(data{i, i % 1500}); break;
+				case 3: result.emplace_back(ack{i, i * 3}); break;
+				case 4: result.emplace_back(nack{i, i * 3, i % 4}); break;
+				default: result.emplace_back(close{i, static_cast<std::uint16_t>(i % 5)}); break;
+			}
+		return result;
+	}
+
+	struct router final {
+		std::uint64_t sum{0};
+
+		void operator()(const ping & msg) noexcept { sum += msg.id; }
+		void operator()(const pong & msg) noexcept { sum -= msg.id; }
+		void operator()(const data & msg) noexcept { sum += msg.size; }
+		void operator()(const ack & msg) noexcept { sum ^= msg.sequence; }
+		void operator()(const nack & msg) noexcept { sum += msg.sequence * msg.reason; }
+		void operator()(const close & msg) noexcept { sum += msg.code; }
+	};
+}
+
+TEST_CASE("variant visit", "[variant]") {
+	const auto pv{make_variants<ptl::variant<int, double, long long>>()};
+	const auto sv{make_variants<std::variant<int, double, long long>>()};
+
+	BENCHMARK("ptl::variant visit") {
+		double sum{0};
+		for(const auto & v : pv) sum += v.visit(to_double{});
+		return sum;
+	};
+	BENCHMARK("std::variant visit") {
+		double sum{0};
+		for(const auto & v : sv) sum += std::visit(to_double{}, v);
+		return sum;
+	};
+	BENCHMARK("ptl::variant holds + get") {
+		double sum{0};
+		for(const auto & v : pv) if(v.holds<double>()) sum += v.get<double>();
+		return sum;
+	};
+	BENCHMARK("std::variant holds_alternative + get") {
+		double sum{0};
+		for(const auto & v : sv) if(std::holds_alternative<double>(v)) sum += std::get<double>(v);
+		return sum;
+	};
+}
+
+//dispatching a visitor that is cheap compared to an indirect call, ptl::variant must not be slower than std::visit
+TEST_CASE("variant message routing", "[variant]") {
+	const auto pv{make_messages<ptl::variant<ping, pong, data, ack, nack, close>>()};
+	const auto sv{make_messages<std::variant<ping, pong, data, ack, nack, close>>()};
+
+	BENCHMARK("ptl::variant visit (6 alternatives)") {
+		router r;
+		for(const auto & msg : pv) msg.visit(r);
+		return r.sum;
+	};
+	BENCHMARK("std::variant visit (6 alternatives)") {
+		router r;
+		for(const auto & msg : sv) std::visit(r, msg);
+		return r.sum;
+	};
+}
+
+TEST_CASE("variant copy", "[variant]") {
+	const auto pv{make_variants<ptl::variant<int, double, long long>>()};
+	const auto sv{make_variants<std::variant<int, double, long long>>()};
+
+	BENCHMARK("ptl::variant copy") { return std::vector<ptl::variant<int, double, long long>>{pv}; };
+	BENCHMARK("std::variant copy") { return std::vector<std::variant<int, double, long long>>{sv}; };
+}
@@ -0,0 +1,114 @@
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <vector>
+#include <cstring>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/string.hpp>
+#include <ptl/vector.hpp>
+
+namespace {
+	struct pod64 final {
+		unsigned char bytes[64];
+	};
+
+	template<typename Vector, typename Type>
+	auto push_back_n(std::size_t count, const Type & value) -> Vector {
+		Vector v;
+		for(std::size_t i{0}; i < count; ++i) v.push_back(value);
+		return v;
+	}
+}
+
+TEST_CASE("vector push_back", "[vector]") {
+	constexpr std::size_t count{100'000};
+	const pod64 pod{};
+	const ptl::string str{"a string exceeding the SSO buffer"};
+
+	BENCHMARK("ptl::vector<int> push_back") { return push_back_n<ptl::vector<int>>(count, 42); };
+	BENCHMARK("std::vector<int> push_back") { return push_back_n<std::vector<int>>(count, 42); };
+	BENCHMARK("ptl::vector<pod64> push_back") { return push_back_n<ptl::vector<pod64>>(count, pod); };
+	BENCHMARK("std::vector<pod64> push_back") { return push_back_n<std::vector<pod64>>(count, pod); };
+	BENCHMARK("ptl::vector<ptl::string> push_back") { return push_back_n<ptl::vector<ptl::string>>(count, str); };
+	BENCHMARK("std::vector<ptl::string> push_back") { return push_back_n<std::vector<ptl::string>>(count, str); };
+}
+
+TEST_CASE("vector resize_for_overwrite", "[vector]") {
+	constexpr std::size_t count{16 << 20};
+	static const std::vector<unsigned char> payload(count, 0xAB);
+
+	BENCHMARK("ptl::vector resize + write 16MB") {
+		ptl::vector<unsigned char> v;
+		v.resize(count);
+		std::memcpy(v.data(), payload.data(), count);
+		return v;
+	};
+	BENCHMARK("ptl::vector resize_for_overwrite + write 16MB") {
+		ptl::vector<unsigned char> v;
+		v.resize_for_overwrite(count);
+		std::memcpy(v.data(), payload.data(), count);
+		return v;
+	};
+	BENCHMARK("std::vector resize + write 16MB") {
+		std::vector<unsigned char> v;
+		v.resize(count);
+		std::memcpy(v.data(), payload.data(), count);
+		return v;
+	};
+}
+
+TEST_CASE("vector resize", "[vector]") {
+	constexpr std::size_t count{1'000'000};
+
+	BENCHMARK("ptl::vector reserve + resize loop") {
+		ptl::vector<int> v;
+		v.reserve(count);
+		for(std::size_t i{1}; i <= count; i += 1'000) v.resize(i);
+		return v;
+	};
+	BENCHMARK("std::vector reserve + resize loop") {
+		std::vector<int> v;
+		v.reserve(count);
+		for(std::size_t i{1}; i <= count; i += 1'000) v.resize(i);
+		return v;
+	};
+	BENCHMARK("ptl::vector resize loop") {
+		ptl::vector<int> v;
+		for(std::size_t i{1}; i <= count; i += 1'000) v.resize(i);
+		return v;
+	};
+	BENCHMARK("std::vector resize loop") {
+		std::vector<int> v;
+		for(std::size_t i{1}; i <= count; i += 1'000) v.resize(i);
+		return v;
+	};
+}
+
+TEST_CASE("vector relocation", "[vector]") {
+	constexpr std::size_t count{1'000'000};
+	const pod64 pod{};
+	const ptl::string str{"a string exceeding the SSO buffer"};
+
+	BENCHMARK("ptl::vector<pod64> reserve doubling") {
+		ptl::vector<pod64> v(count, pod);
+		v.reserve(count * 2);
+		return v;
+	};
+	BENCHMARK("std::vector<pod64> reserve doubling") {
+		std::vector<pod64> v(count, pod);
+		v.reserve(count * 2);
+		return v;
+	};
+	BENCHMARK("ptl::vector<ptl::string> reserve doubling") {
+		ptl::vector<ptl::string> v(count / 10, str);
+		v.reserve(count / 5);
+		return v;
+	};
+	BENCHMARK("std::vector<ptl::string> reserve doubling") {
+		std::vector<ptl::string> v(count / 10, str);
+		v.reserve(count / 5);
+		return v;
+	};
+}
@@ -0,0 +1,158 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <algorithm>
+
+namespace ptl {
+	//! @brief binary stable interface to a user-provided memory resource
+	//! @note only consists of function pointers => may be implemented by any compiler (or even language)
+	//! @attention a policy must outlive every container that allocated memory from it
+	struct allocation_policy {
+		//! @brief allocate memory aligned for std::max_align_t
+		//! @returns nullptr on failure
+		void * (*allocate)(allocation_policy * self, std::size_t size) noexcept;
+		//! @brief release memory previously obtained from allocate
+		//! @note size is always the exact value passed to the corresponding allocate
+		void (*deallocate)(allocation_policy * self, void * ptr, std::size_t size) noexcept;
+	};
+
+	namespace internal_allocation_policy {
+		//memory obtained from a policy is prefixed with this header => the deallocator stored in a container can always locate its policy, independent of the binary that frees the memory
+		struct header final {
+			allocation_policy * policy;
+			std::size_t size; //including the header
+		};
+
+		inline
+		constexpr
+		std::size_t alignment{alignof(std::max_align_t)};
+
+		inline
+		constexpr
+		std::size_t header_size{(sizeof(header) + alignment - 1) / alignment * alignment};
+
+		inline
+		auto allocate(allocation_policy & policy, std::size_t size) -> void * {
+			if(size > std::numeric_limits<std::size_t>::max() - header_size) throw std::bad_alloc{};
+			size += header_size;
+			const auto ptr{static_cast<unsigned char *>(policy.allocate(&policy, size))};
+			if(!ptr) throw std::bad_alloc{};
+			new(ptr) header{&policy, size};
+			return ptr + header_size;
+		}
+
+		inline
+		auto header_of(void * ptr) noexcept -> header * { return reinterpret_cast<header *>(static_cast<unsigned char *>(ptr) - header_size); }
+
+		//address identifies memory obtained from a policy, so it must not be replaced by a lambda
+		template<typename Type>
+		void deallocate(Type * ptr) noexcept {
+			const auto h{header_of(ptr)};
+			h->policy->deallocate(h->policy, h, h->size);
+		}
+
+		//policy that allocated ptr, nullptr if dealloc is not the deallocator of this binary (e.g. the default heap or memory from another binary)
+		template<typename Type>
+		auto policy_of(void(*dealloc)(Type *) noexcept, Type * ptr) noexcept -> allocation_policy * { return dealloc == &deallocate<Type> ? header_of(ptr)->policy : nullptr; }
+
+		inline
+		auto align(std::size_t size) noexcept -> std::size_t { return (size + alignment - 1) / alignment * alignment; }
+	}
+
+	//! @brief bump allocator that releases all memory at once when destroyed
+	//! @note deallocation is a no-op, making this policy ideal for short-lived containers (e.g. per request)
+	//! @attention not thread-safe
+	class arena_policy final : public allocation_policy {
+		struct chunk final {
+			chunk * next;
+			std::size_t size; //usable bytes following the chunk header
+		};
+		static_assert(sizeof(chunk) <= internal_allocation_policy::alignment);
+
+		std::size_t chunk_size;
+		chunk * chunks{nullptr};
+		unsigned char * first{nullptr}, * last{nullptr};
+
+		static
+		auto allocate_impl(allocation_policy * self, std::size_t size) noexcept -> void * {
+			auto & arena{*static_cast<arena_policy *>(self)};
+			size = internal_allocation_policy::align(size);
+			if(static_cast<std::size_t>(arena.last - arena.first) < size) {
+				const auto usable{std::max(arena.chunk_size, size)};
+				const auto ptr{static_cast<chunk *>(std::malloc(internal_allocation_policy::alignment + usable))};
+				if(!ptr) return nullptr;
+				arena.chunks = new(ptr) chunk{arena.chunks, usable};
+				arena.first = reinterpret_cast<unsigned char *>(ptr) + internal_allocation_policy::alignment;
+				arena.last = arena.first + usable;
+			}
+			return std::exchange(arena.first, arena.first + size);
+		}
+
+		static
+		void deallocate_impl(allocation_policy *, void *, std::size_t) noexcept {}
+	public:
+		//! @param[in] chunk_size minimal number of bytes requested from the global heap at once
+		explicit
+		arena_policy(std::size_t chunk_size = 64 * 1024) noexcept : allocation_policy{allocate_impl, deallocate_impl}, chunk_size{chunk_size} {}
+		arena_policy(const arena_policy &) =delete;
+		auto operator=(const arena_policy &) -> arena_policy & =delete;
+		~arena_policy() noexcept { release(); }
+
+		//! @brief release all memory at once
+		//! @attention invalidates all memory allocated from this arena
+		void release() noexcept {
+			while(chunks) std::free(std::exchange(chunks, chunks->next));
+			first = last = nullptr;
+		}
+	};
+
+	//! @brief allocator for blocks of a fixed size, recycling released blocks
+	//! @note requests exceeding the block size are forwarded to the global heap
+	//! @attention not thread-safe
+	class pool_policy final : public allocation_policy {
+		struct node final { node * next; };
+
+		std::size_t block_size, blocks_per_chunk;
+		void * chunks{nullptr}; //first pointer-sized bytes of each chunk link to the next chunk
+		node * free{nullptr};
+
+		static
+		auto allocate_impl(allocation_policy * self, std::size_t size) noexcept -> void * {
+			auto & pool{*static_cast<pool_policy *>(self)};
+			if(size > pool.block_size) return std::malloc(size);
+			if(!pool.free) {
+				const auto ptr{static_cast<unsigned char *>(std::malloc(internal_allocation_policy::alignment + pool.block_size * pool.blocks_per_chunk))};
+				if(!ptr) return nullptr;
+				*reinterpret_cast<void **>(ptr) = std::exchange(pool.chunks, ptr);
+				for(auto i{pool.blocks_per_chunk}; i != 0; --i) pool.free = new(ptr + internal_allocation_policy::alignment + (i - 1) * pool.block_size) node{pool.free};
+			}
+			return std::exchange(pool.free, pool.free->next);
+		}
+
+		static
+		void deallocate_impl(allocation_policy * self, void * ptr, std::size_t size) noexcept {
+			auto & pool{*static_cast<pool_policy *>(self)};
+			if(size > pool.block_size) std::free(ptr);
+			else pool.free = new(ptr) node{pool.free};
+		}
+	public:
+		//! @param[in] block_size size of each block (including the bookkeeping of the containers)
+		//! @param[in] blocks_per_chunk number of blocks requested from the global heap at once
+		explicit
+		pool_policy(std::size_t block_size, std::size_t blocks_per_chunk = 64) noexcept : allocation_policy{allocate_impl, deallocate_impl}, block_size{internal_allocation_policy::align(std::max(block_size, sizeof(node)))}, blocks_per_chunk{std::max(blocks_per_chunk, std::size_t{1})} {}
+		pool_policy(const pool_policy &) =delete;
+		auto operator=(const pool_policy &) -> pool_policy & =delete;
+		~pool_policy() noexcept {
+			while(chunks) std::free(std::exchange(chunks, *static_cast<void **>(chunks)));
+		}
+	};
+}
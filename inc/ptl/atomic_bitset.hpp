@@ -0,0 +1,153 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "bitset.hpp"
+#include "internal/utils.hpp"
+
+namespace ptl {
+	namespace internal_atomic_bitset {
+		static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t));
+		static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+		constexpr
+		auto words(std::size_t size) noexcept -> std::size_t { return size / 64 + (size % 64 ? 1 : 0); }
+
+		//bits of word index that belong to a bitset of size bits
+		constexpr
+		auto valid_bits(std::size_t size, std::size_t index) noexcept -> std::uint64_t {
+			const auto remaining{size - index * 64};
+			return remaining >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << remaining) - 1;
+		}
+	}
+
+	//! @brief a fixed-size sequence of bits that may be modified concurrently without locks, e.g. as the free-list of a pool of slots
+	//! @tparam Size size of the bitset
+	//! @tparam Tag to differenciate unrelated bitsets of the same size, matching ptl::bitset
+	//! @note binary stable layout: Size / 64 (rounded up) std::atomic<std::uint64_t>, bit i is stored in bit i % 64 of word i / 64 => on little endian hosts the bytes match ptl::bitset<Size, Tag> (padded to a multiple of 8 bytes)
+	//! @note operations on a single bit or word are atomic, operations on the whole bitset (e.g. count) are not a consistent snapshot while it is modified
+	template<std::size_t Size, typename Tag = struct bitset_default_tag>
+	class atomic_bitset final {
+		static
+		constexpr
+		std::size_t word_count{internal_atomic_bitset::words(Size)};
+
+		std::atomic<std::uint64_t> words[word_count ? word_count : 1]{};
+
+		static
+		constexpr
+		auto valid_bits(std::size_t index) noexcept -> std::uint64_t { return internal_atomic_bitset::valid_bits(Size, index); }
+		static
+		constexpr
+		auto mask(std::size_t index) noexcept -> std::uint64_t { return std::uint64_t{1} << (index % 64); }
+
+		//try to set the lowest unset bit of candidates in word index
+		auto claim_in(std::size_t index, std::uint64_t candidates, std::memory_order order) noexcept -> std::size_t {
+			auto & word{words[index]};
+			auto value{word.load(std::memory_order_relaxed)};
+			while(const auto free{~value & candidates}) {
+				const auto bit{free & (~free + 1)};
+				if(word.compare_exchange_weak(value, value | bit, order, std::memory_order_relaxed)) return index * 64 + internal_utils::countr_zero(bit);
+			}
+			return Size;
+		}
+	public:
+		using size_type = std::size_t;
+
+		constexpr
+		atomic_bitset() noexcept =default;
+		explicit
+		atomic_bitset(const bitset<Size, Tag> & bits) noexcept { store(bits, std::memory_order_relaxed); }
+		atomic_bitset(const atomic_bitset &) =delete;
+		auto operator=(const atomic_bitset &) -> atomic_bitset & =delete;
+		~atomic_bitset() noexcept =default;
+
+		static
+		constexpr
+		auto size() noexcept -> size_type { return Size; }
+
+		//! @returns number of 64-bit words, word i stores the bits [i * 64, i * 64 + 64)
+		static
+		constexpr
+		auto word_size() noexcept -> size_type { return word_count; }
+
+		auto test(size_type index, std::memory_order order = std::memory_order_seq_cst) const noexcept -> bool { return words[index / 64].load(order) & mask(index); } //TODO: [C++??] precondition(index < Size);
+
+		//! @brief set a bit
+		//! @returns previous value of the bit
+		auto test_and_set(size_type index, std::memory_order order = std::memory_order_seq_cst) noexcept -> bool { return words[index / 64].fetch_or(mask(index), order) & mask(index); } //TODO: [C++??] precondition(index < Size);
+		//! @brief reset a bit, e.g. to release a slot claimed by claim_first_zero
+		//! @returns previous value of the bit
+		auto test_and_reset(size_type index, std::memory_order order = std::memory_order_seq_cst) noexcept -> bool { return words[index / 64].fetch_and(~mask(index), order) & mask(index); } //TODO: [C++??] precondition(index < Size);
+		//! @brief flip a bit
+		//! @returns previous value of the bit
+		auto test_and_flip(size_type index, std::memory_order order = std::memory_order_seq_cst) noexcept -> bool { return words[index / 64].fetch_xor(mask(index), order) & mask(index); } //TODO: [C++??] precondition(index < Size);
+
+		void set(size_type index, std::memory_order order = std::memory_order_seq_cst) noexcept { test_and_set(index, order); }
+		void reset(size_type index, std::memory_order order = std::memory_order_seq_cst) noexcept { test_and_reset(index, order); }
+
+		auto load_word(size_type index, std::memory_order order = std::memory_order_seq_cst) const noexcept -> std::uint64_t { return words[index].load(order); } //TODO: [C++??] precondition(index < word_size());
+		//! @brief set the bits of value in word index, bits beyond size() are ignored
+		//! @returns previous value of the word
+		auto fetch_or(size_type index, std::uint64_t value, std::memory_order order = std::memory_order_seq_cst) noexcept -> std::uint64_t { return words[index].fetch_or(value & valid_bits(index), order); } //TODO: [C++??] precondition(index < word_size());
+		//! @brief keep only the bits of value in word index
+		//! @returns previous value of the word
+		auto fetch_and(size_type index, std::uint64_t value, std::memory_order order = std::memory_order_seq_cst) noexcept -> std::uint64_t { return words[index].fetch_and(value, order); } //TODO: [C++??] precondition(index < word_size());
+
+		//! @brief atomically set the first unset bit at or after start, wrapping around to the beginning
+		//! @param[in] start position to begin the search at, spreading threads over different words reduces contention
+		//! @returns index of the bit that was set by this call, size() if all bits were set
+		//! @note lock-free: a failed compare-exchange implies that another thread modified the word
+		auto claim_first_zero(size_type start = 0, std::memory_order order = std::memory_order_seq_cst) noexcept -> size_type { //TODO: [C++??] precondition(start <= Size);
+			if constexpr(Size == 0) return Size;
+			else {
+				if(start == Size) start = 0;
+				const auto first{start / 64};
+				const auto above{~std::uint64_t{0} << (start % 64)};
+				if(const auto result{claim_in(first, valid_bits(first) & above, order)}; result != Size) return result;
+				for(auto i{first + 1}; i < word_count; ++i)
+					if(const auto result{claim_in(i, valid_bits(i), order)}; result != Size)
+						return result;
+				for(size_type i{0}; i < first; ++i)
+					if(const auto result{claim_in(i, ~std::uint64_t{0}, order)}; result != Size)
+						return result;
+				return claim_in(first, ~above, order);
+			}
+		}
+
+		auto count(std::memory_order order = std::memory_order_seq_cst) const noexcept -> size_type {
+			size_type result{0};
+			for(const auto & word : words) result += internal_utils::popcount(word.load(order));
+			return result;
+		}
+		auto all(std::memory_order order = std::memory_order_seq_cst) const noexcept -> bool { return count(order) == Size; }
+		auto any(std::memory_order order = std::memory_order_seq_cst) const noexcept -> bool {
+			for(const auto & word : words)
+				if(word.load(order))
+					return true;
+			return false;
+		}
+		auto none(std::memory_order order = std::memory_order_seq_cst) const noexcept -> bool { return !any(order); }
+
+		//! @brief copy all bits, each word is read atomically
+		auto load(std::memory_order order = std::memory_order_seq_cst) const noexcept -> bitset<Size, Tag> {
+			bitset<Size, Tag> result;
+			for(size_type i{0}; i < word_count; ++i)
+				for(auto value{words[i].load(order)}; value; value &= value - 1)
+					result.set(i * 64 + internal_utils::countr_zero(value));
+			return result;
+		}
+		//! @brief replace all bits, each word is written atomically
+		void store(const bitset<Size, Tag> & bits, std::memory_order order = std::memory_order_seq_cst) noexcept {
+			if constexpr(Size != 0) {
+				const auto bytes{Size / 8 + (Size % 8 ? 1 : 0)};
+				for(size_type i{0}; i < word_count; ++i) words[i].store(internal_bitset::load(bits.data() + i * 8, bytes - i * 8), order);
+			}
+		}
+	};
+}
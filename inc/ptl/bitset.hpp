@@ -5,17 +5,319 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #pragma once
+#include <string>
 #include <climits>
+#include <charconv>
+#include <cstdint>
 #include <istream>
+#include <iterator>
 #include <ostream>
-#include <numeric>
 #include <algorithm>
 #include <type_traits>
+#include "hash.hpp"
+#include "internal/utils.hpp"
 
 namespace ptl {
 	namespace internal_bitset {
 		static_assert(CHAR_BIT == 8);
-		//TODO: endianess?
+
+		using internal_utils::is_constant_evaluated;
+
+		//bits are stored in little endian order (bit i resides in bit i % 8 of byte i / 8) => assembling little endian words keeps this property independent of the host
+		constexpr
+		auto load(const unsigned char * ptr) noexcept -> std::uint64_t { return internal_utils::load64(ptr); }
+
+		constexpr
+		void store(unsigned char * ptr, std::uint64_t value) noexcept { internal_utils::store64(ptr, value); }
+
+		//loads up to 8 bytes, missing bytes are treated as zero
+		constexpr
+		auto load(const unsigned char * ptr, std::size_t size) noexcept -> std::uint64_t {
+			if(size >= 8) return load(ptr);
+			std::uint64_t result{0};
+			for(std::size_t i{0}; i < size; ++i) result |= std::uint64_t{ptr[i]} << (i * 8);
+			return result;
+		}
+
+		using internal_utils::popcount;
+		using internal_utils::countr_zero;
+		using internal_utils::countl_zero;
+
+		struct and_op final {
+			template<typename T>
+			constexpr
+			auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs & rhs); }
+		#if defined(__AVX2__)
+			auto operator()(__m256i lhs, __m256i rhs) const noexcept -> __m256i { return _mm256_and_si256(lhs, rhs); }
+		#elif defined(PTL_INTERNAL_SSE2)
+			auto operator()(__m128i lhs, __m128i rhs) const noexcept -> __m128i { return _mm_and_si128(lhs, rhs); }
+		#endif
+		};
+
+		struct or_op final {
+			template<typename T>
+			constexpr
+			auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs | rhs); }
+		#if defined(__AVX2__)
+			auto operator()(__m256i lhs, __m256i rhs) const noexcept -> __m256i { return _mm256_or_si256(lhs, rhs); }
+		#elif defined(PTL_INTERNAL_SSE2)
+			auto operator()(__m128i lhs, __m128i rhs) const noexcept -> __m128i { return _mm_or_si128(lhs, rhs); }
+		#endif
+		};
+
+		struct xor_op final {
+			template<typename T>
+			constexpr
+			auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs ^ rhs); }
+		#if defined(__AVX2__)
+			auto operator()(__m256i lhs, __m256i rhs) const noexcept -> __m256i { return _mm256_xor_si256(lhs, rhs); }
+		#elif defined(PTL_INTERNAL_SSE2)
+			auto operator()(__m128i lhs, __m128i rhs) const noexcept -> __m128i { return _mm_xor_si128(lhs, rhs); }
+		#endif
+		};
+
+		struct not_op final { //unary, ignores rhs
+			template<typename T>
+			constexpr
+			auto operator()(T lhs, T) const noexcept -> T { return static_cast<T>(~lhs); }
+		#if defined(__AVX2__)
+			auto operator()(__m256i lhs, __m256i) const noexcept -> __m256i { return _mm256_xor_si256(lhs, _mm256_set1_epi32(-1)); }
+		#elif defined(PTL_INTERNAL_SSE2)
+			auto operator()(__m128i lhs, __m128i) const noexcept -> __m128i { return _mm_xor_si128(lhs, _mm_set1_epi32(-1)); }
+		#endif
+		};
+
+		template<typename Op>
+		constexpr
+		void transform(unsigned char * lhs, const unsigned char * rhs, std::size_t size, Op op) noexcept {
+			std::size_t i{0};
+			if(!is_constant_evaluated()) {
+			#if defined(__AVX2__)
+				for(; i + 32 <= size; i += 32) _mm256_storeu_si256(reinterpret_cast<__m256i *>(lhs + i), op(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i))));
+			#elif defined(PTL_INTERNAL_SSE2)
+				for(; i + 16 <= size; i += 16) _mm_storeu_si128(reinterpret_cast<__m128i *>(lhs + i), op(_mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i))));
+			#endif
+			}
+			for(; i + 8 <= size; i += 8) store(lhs + i, op(load(lhs + i), load(rhs + i)));
+			for(; i < size; ++i) lhs[i] = op(lhs[i], rhs[i]);
+		}
+
+		constexpr
+		auto any(const unsigned char * ptr, std::size_t size) noexcept -> bool {
+			std::size_t i{0};
+			if(!is_constant_evaluated()) {
+			#if defined(__AVX2__)
+				for(; i + 32 <= size; i += 32)
+					if(const auto val{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr + i))}; !_mm256_testz_si256(val, val))
+						return true;
+			#elif defined(PTL_INTERNAL_SSE2)
+				for(; i + 16 <= size; i += 16)
+					if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i)), _mm_setzero_si128())) != 0xFFFF)
+						return true;
+			#endif
+			}
+			for(; i + 8 <= size; i += 8)
+				if(load(ptr + i))
+					return true;
+			for(; i < size; ++i)
+				if(ptr[i])
+					return true;
+			return false;
+		}
+
+		constexpr
+		auto all(const unsigned char * ptr, std::size_t size) noexcept -> bool {
+			std::size_t i{0};
+			if(!is_constant_evaluated()) {
+			#if defined(__AVX2__)
+				for(; i + 32 <= size; i += 32)
+					if(!_mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr + i)), _mm256_set1_epi32(-1)))
+						return false;
+			#elif defined(PTL_INTERNAL_SSE2)
+				for(; i + 16 <= size; i += 16)
+					if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i)), _mm_set1_epi32(-1))) != 0xFFFF)
+						return false;
+			#endif
+			}
+			for(; i + 8 <= size; i += 8)
+				if(~load(ptr + i))
+					return false;
+			for(; i < size; ++i)
+				if(ptr[i] != 255)
+					return false;
+			return true;
+		}
+
+		constexpr
+		auto equal(const unsigned char * lhs, const unsigned char * rhs, std::size_t size) noexcept -> bool {
+			std::size_t i{0};
+			if(!is_constant_evaluated()) {
+			#if defined(__AVX2__)
+				for(; i + 32 <= size; i += 32)
+					if(const auto val{_mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i)))}; !_mm256_testz_si256(val, val))
+						return false;
+			#elif defined(PTL_INTERNAL_SSE2)
+				for(; i + 16 <= size; i += 16)
+					if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i)))) != 0xFFFF)
+						return false;
+			#endif
+			}
+			for(; i + 8 <= size; i += 8)
+				if(load(lhs + i) != load(rhs + i))
+					return false;
+			for(; i < size; ++i)
+				if(lhs[i] != rhs[i])
+					return false;
+			return true;
+		}
+
+		constexpr
+		auto count(const unsigned char * ptr, std::size_t size) noexcept -> std::size_t {
+			std::size_t result{0}, i{0};
+			for(; i + 8 <= size; i += 8) result += popcount(load(ptr + i));
+			for(; i < size; ++i) result += popcount(ptr[i]);
+			return result;
+		}
+
+		//index of the first set bit at or after index, size * 8 if there is none
+		constexpr
+		auto find_next(const unsigned char * ptr, std::size_t size, std::size_t index) noexcept -> std::size_t {
+			auto i{index / 8};
+			if(i >= size) return size * 8;
+			if(i + 8 <= size) { //probing a whole word first keeps iterating over dense bitsets cheap
+				if(const auto val{load(ptr + i) & (~std::uint64_t{0} << (index % 8))}) return i * 8 + countr_zero(val);
+				i += 8;
+			} else {
+				if(const auto val{static_cast<unsigned char>(ptr[i] & (255 << (index % 8)))}) return i * 8 + countr_zero(val);
+				++i;
+			}
+			if(!is_constant_evaluated()) { //skip runs of zeros, the word loop below locates the bit within the block
+			#if defined(__AVX2__)
+				for(; i + 32 <= size; i += 32)
+					if(const auto val{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr + i))}; !_mm256_testz_si256(val, val))
+						break;
+			#elif defined(PTL_INTERNAL_SSE2)
+				for(; i + 16 <= size; i += 16)
+					if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i)), _mm_setzero_si128())) != 0xFFFF)
+						break;
+			#endif
+			}
+			for(; i + 8 <= size; i += 8)
+				if(const auto val{load(ptr + i)})
+					return i * 8 + countr_zero(val);
+			for(; i < size; ++i)
+				if(ptr[i])
+					return i * 8 + countr_zero(ptr[i]);
+			return size * 8;
+		}
+
+		//index of the last set bit, size * 8 if there is none
+		constexpr
+		auto find_last(const unsigned char * ptr, std::size_t size) noexcept -> std::size_t {
+			auto i{size};
+			for(; i >= 8; i -= 8)
+				if(const auto val{load(ptr + i - 8)})
+					return i * 8 - 1 - countl_zero(val);
+			for(; i != 0; --i)
+				if(ptr[i - 1])
+					return i * 8 - 1 - (countl_zero(ptr[i - 1]) - 56);
+			return size * 8;
+		}
+
+		//shift towards higher indices, processing whole words with the sub-byte shift folded in => cost is independent of count
+		constexpr
+		void shift_left(unsigned char * ptr, std::size_t size, std::size_t count) noexcept { //TODO: [C++??] precondition(count < size * 8);
+			const auto bytes{count / 8};
+			const auto bits{static_cast<unsigned>(count % 8)};
+			auto i{size};
+			for(; i >= bytes + 9; i -= 8) store(ptr + i - 8, (load(ptr + i - 8 - bytes) << bits) | (ptr[i - 9 - bytes] >> (8 - bits)));
+			for(; i > bytes; --i) {
+				const auto src{i - 1 - bytes};
+				ptr[i - 1] = static_cast<unsigned char>((ptr[src] << bits) | (src != 0 ? ptr[src - 1] >> (8 - bits) : 0));
+			}
+			for(; i != 0; --i) ptr[i - 1] = 0;
+		}
+
+		//shift towards lower indices, processing whole words with the sub-byte shift folded in => cost is independent of count
+		constexpr
+		void shift_right(unsigned char * ptr, std::size_t size, std::size_t count) noexcept { //TODO: [C++??] precondition(count < size * 8);
+			const auto bytes{count / 8};
+			const auto bits{static_cast<unsigned>(count % 8)};
+			std::size_t i{0};
+			for(; i + bytes + 9 <= size; i += 8) store(ptr + i, (load(ptr + i + bytes) >> bits) | (bits ? std::uint64_t{ptr[i + bytes + 8]} << (64 - bits) : 0));
+			for(; i + bytes < size; ++i) {
+				const auto src{i + bytes};
+				ptr[i] = static_cast<unsigned char>((ptr[src] >> bits) | (src + 1 < size ? ptr[src + 1] << (8 - bits) : 0));
+			}
+			for(; i < size; ++i) ptr[i] = 0;
+		}
+
+		//writes the 8 binary digits of byte, most significant bit first => spreads the bits over a word and converts all of them at once
+		inline
+		void to_binary(unsigned char byte, char * out) noexcept {
+			const auto bits{((byte * std::uint64_t{0x0101010101010101} & 0x0102040810204080) + 0x7F7F7F7F7F7F7F7F) & 0x8080808080808080}; //bit 7 - i is moved to bit 7 of byte i
+			store(reinterpret_cast<unsigned char *>(out), (bits >> 7) + 0x3030303030303030);
+		}
+
+		//if the next 8 characters are binary digits stores their value in byte
+		inline
+		auto from_binary(const char * ptr, unsigned char & byte) noexcept -> bool {
+			const auto chars{load(reinterpret_cast<const unsigned char *>(ptr))};
+			if((chars & 0xFEFEFEFEFEFEFEFE) != 0x3030303030303030) return false;
+			byte = static_cast<unsigned char>(((chars & 0x0101010101010101) * 0x8040201008040201) >> 56); //bit 0 of byte i is moved to bit 7 - i of the top byte
+			return true;
+		}
+
+		inline
+		auto hex_value(char c) noexcept -> int {
+			if(c >= '0' && c <= '9') return c - '0';
+			if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		}
+
+		inline
+		constexpr
+		char hex_digits[]{"0123456789abcdef"};
+
+		//most significant digit first, size is the number of bits
+		inline
+		void to_chars(const unsigned char * ptr, std::size_t size, char * out, int base) noexcept {
+			auto i{(size + 7) / 8};
+			if(base == 2) {
+				if(const auto partial{size % 8}) { //leading digits of the incomplete byte
+					--i;
+					for(auto bit{partial}; bit != 0; --bit) *out++ = static_cast<char>('0' + ((ptr[i] >> (bit - 1)) & 1));
+				}
+				for(; i != 0; --i, out += 8) to_binary(ptr[i - 1], out);
+			} else {
+				if(const auto digits{(size + 3) / 4}; digits % 2) *out++ = hex_digits[ptr[--i] & 15];
+				for(; i != 0; --i, out += 2) {
+					out[0] = hex_digits[ptr[i - 1] >> 4];
+					out[1] = hex_digits[ptr[i - 1] & 15];
+				}
+			}
+		}
+
+		//parses up to max_digits digits, the last digit being the least significant => ptr must be zeroed and provide storage for max_digits digits
+		inline
+		auto from_chars(unsigned char * ptr, const char * first, const char * last, std::size_t max_digits, int base) noexcept -> const char * {
+			const auto limit{first + static_cast<std::ptrdiff_t>(std::min(static_cast<std::size_t>(last - first), max_digits))};
+			auto end{first};
+			if(base == 2) {
+				for(unsigned char byte; limit - end >= 8 && from_binary(end, byte);) end += 8;
+				while(end != limit && (*end == '0' || *end == '1')) ++end;
+				auto pos{end};
+				for(; pos - first >= 8; pos -= 8) from_binary(pos - 8, *ptr++);
+				for(auto it{first}; it != pos; ++it) *ptr = static_cast<unsigned char>((*ptr << 1) | (*it - '0'));
+			} else {
+				while(end != limit && hex_value(*end) >= 0) ++end;
+				auto pos{end};
+				for(; pos - first >= 2; pos -= 2) *ptr++ = static_cast<unsigned char>(hex_value(pos[-2]) << 4 | hex_value(pos[-1]));
+				if(pos != first) *ptr = static_cast<unsigned char>(hex_value(*first));
+			}
+			return end;
+		}
 
 		template<std::size_t Size>
 		constexpr //TODO: [C++20] replace with consteval
@@ -29,6 +331,77 @@ namespace ptl {
 		constexpr
 		unsigned char trailing_bits{determine_trailing_mask<Size>()};
 
+		//number of bytes storing the given number of bits
+		constexpr
+		auto bytes(std::size_t bits) noexcept -> std::size_t { return bits / 8 + (bits % 8 ? 1 : 0); }
+
+		//forward iterator over the indices of the set bits among the first size bits of ptr, bits beyond size must be zero
+		class set_bit_iterator final {
+			const unsigned char * ptr{nullptr};
+			std::size_t size{0}, index{0};
+			std::uint64_t word{0}; //remaining set bits of the 64-bit block containing index => advancing only scans memory when the block is exhausted
+
+			constexpr
+			void load_word() noexcept {
+				if(index >= size) return;
+				const auto offset{index / 64 * 8};
+				word = load(ptr + offset, bytes(size) - offset) & (~std::uint64_t{0} << (index % 64));
+			}
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = std::size_t;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = const std::size_t *;
+			using reference         = std::size_t;
+
+			constexpr
+			set_bit_iterator() noexcept =default;
+			constexpr
+			set_bit_iterator(const unsigned char * ptr, std::size_t size, std::size_t index) noexcept : ptr{ptr}, size{size}, index{index} { load_word(); }
+
+			constexpr
+			auto operator++() noexcept -> set_bit_iterator & { //TODO: [C++??] precondition(index < size);
+				word &= word - 1;
+				if(word) index = index / 64 * 64 + countr_zero(word);
+				else {
+					const auto next{(index | 63) + 1};
+					index = next < size ? std::min(find_next(ptr, bytes(size), next), size) : size;
+					load_word();
+				}
+				return *this;
+			}
+			constexpr
+			auto operator++(int) noexcept -> set_bit_iterator {
+				auto tmp{*this};
+				++*this;
+				return tmp;
+			}
+
+			constexpr
+			auto operator*() const noexcept -> reference { return index; }
+
+			friend
+			constexpr
+			auto operator==(const set_bit_iterator & lhs, const set_bit_iterator & rhs) noexcept -> bool { return lhs.index == rhs.index; }
+			friend
+			constexpr
+			auto operator!=(const set_bit_iterator & lhs, const set_bit_iterator & rhs) noexcept -> bool { return !(lhs == rhs); } //TODO: [C++20] remove as implicitly generated
+		};
+
+		//range of the indices of the set bits among the first size bits of ptr in ascending order
+		class set_bit_range final {
+			const unsigned char * ptr;
+			std::size_t size;
+		public:
+			constexpr
+			set_bit_range(const unsigned char * ptr, std::size_t size) noexcept : ptr{ptr}, size{size} {}
+
+			constexpr
+			auto begin() const noexcept -> set_bit_iterator { return {ptr, size, std::min(find_next(ptr, bytes(size), 0), size)}; }
+			constexpr
+			auto end() const noexcept -> set_bit_iterator { return {ptr, size, size}; }
+		};
+
 		template<std::size_t Size>
 		struct storage final { using type = unsigned char[(Size / 8) + (Size % 8 ? 1 : 0)]; };
 
@@ -95,7 +468,7 @@ namespace ptl {
 			}
 
 			constexpr
-			operator bool() const noexcept { return self[index]; }
+			operator bool() const noexcept { return static_cast<const bitset &>(self)[index]; }
 			constexpr
 			auto operator~() const noexcept -> bool { return !static_cast<bool>(*this); }
 
@@ -157,14 +530,13 @@ namespace ptl {
 		auto all() const noexcept -> bool {
 			if constexpr(Size == 0) return true;
 			else {
-				const auto it{values + sizeof(values) - 1};
-				return std::all_of(values, it, [](auto val) { return val == 255; }) && *it == internal_bitset::trailing_bits<Size>;
+				return internal_bitset::all(values, sizeof(values) - 1) && values[sizeof(values) - 1] == internal_bitset::trailing_bits<Size>;
 			}
 		}
 		constexpr
 		auto any() const noexcept -> bool {
 			if constexpr(Size == 0) return false;
-			else return std::any_of(values, values + sizeof(values), [](auto val) { return val != 0; });
+			else return internal_bitset::any(values, sizeof(values));
 		}
 		constexpr
 		auto none() const noexcept -> bool { return !any(); }
@@ -172,10 +544,50 @@ namespace ptl {
 		constexpr
 		auto count() const noexcept -> size_type {
 			if constexpr(Size == 0) return 0;
-			else return std::accumulate(values, values + sizeof(values), size_type{}, [](auto sum, auto val) {
-				constexpr unsigned char nibble_count[]{0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
-				return sum + (nibble_count[val >> 4] + nibble_count[val & 15]);
-			});
+			else return internal_bitset::count(values, sizeof(values));
+		}
+
+		//! @brief find the first set bit
+		//! @returns index of the first set bit or size() if no bit is set
+		constexpr
+		auto find_first() const noexcept -> size_type {
+			if constexpr(Size == 0) return 0;
+			else return std::min(internal_bitset::find_next(values, sizeof(values), 0), Size);
+		}
+		//! @brief find the next set bit
+		//! @param[in] index position to search after
+		//! @returns index of the first set bit after index or size() if there is none
+		constexpr
+		auto find_next(size_type index) const noexcept -> size_type {
+			if constexpr(Size == 0) return 0;
+			else {
+				if(index >= Size - 1) return Size;
+				return std::min(internal_bitset::find_next(values, sizeof(values), index + 1), Size);
+			}
+		}
+		//! @brief find the last set bit
+		//! @returns index of the last set bit or size() if no bit is set
+		constexpr
+		auto find_last() const noexcept -> size_type {
+			if constexpr(Size == 0) return 0;
+			else return std::min(internal_bitset::find_last(values, sizeof(values)), Size);
+		}
+
+		//! @brief forward iterator over the indices of all set bits
+		using set_bit_iterator = internal_bitset::set_bit_iterator;
+		//! @brief range of the indices of all set bits in ascending order
+		//! @attention the range is invalidated by modifications of the bitset
+		using set_bit_range = internal_bitset::set_bit_range;
+
+		//! @brief iterate over the indices of all set bits
+		constexpr
+		auto set_bits() const noexcept -> set_bit_range { return {data(), Size}; }
+
+		//! @returns underlying bytes, bit i is stored in bit i % 8 of byte i / 8, nullptr if size() is 0
+		constexpr
+		auto data() const noexcept -> const unsigned char * {
+			if constexpr(Size == 0) return nullptr;
+			else return values;
 		}
 
 		static
@@ -191,7 +603,7 @@ namespace ptl {
 
 		constexpr
 		auto operator&=(const bitset & other) noexcept -> bitset & {
-			if constexpr(Size != 0) std::transform(values, values + sizeof(values), other.values, values, [](const auto & lhs, const auto & rhs) { return static_cast<unsigned char>(lhs & rhs); });
+			if constexpr(Size != 0) internal_bitset::transform(values, other.values, sizeof(values), internal_bitset::and_op{});
 			return *this;
 		}
 		friend
@@ -203,7 +615,7 @@ namespace ptl {
 
 		constexpr
 		auto operator|=(const bitset & other) noexcept -> bitset & {
-			if constexpr(Size != 0) std::transform(values, values + sizeof(values), other.values, values, [](const auto & lhs, const auto & rhs) { return static_cast<unsigned char>(lhs | rhs); });
+			if constexpr(Size != 0) internal_bitset::transform(values, other.values, sizeof(values), internal_bitset::or_op{});
 			return *this;
 		}
 		friend
@@ -215,7 +627,7 @@ namespace ptl {
 
 		constexpr
 		auto operator^=(const bitset & other) noexcept -> bitset & {
-			if constexpr(Size != 0) std::transform(values, values + sizeof(values), other.values, values, [](const auto & lhs, const auto & rhs) { return static_cast<unsigned char>(lhs ^ rhs); });
+			if constexpr(Size != 0) internal_bitset::transform(values, other.values, sizeof(values), internal_bitset::xor_op{});
 			return *this;
 		}
 		friend
@@ -235,14 +647,9 @@ namespace ptl {
 		constexpr
 		auto operator<<=(size_type count) noexcept -> bitset & {
 			if constexpr(Size != 0) {
-				for(size_type i{0}; i < count; ++i) {
-					for(size_type j{sizeof(values) - 1}; j > 0; --j) {
-						values[j] = static_cast<unsigned char>(values[j] << 1);
-						values[j] = static_cast<unsigned char>(values[j] | (values[j - 1] >> 7));
-					}
-					values[0] = static_cast<unsigned char>(values[0] << 1);
-					clear_trailing_bits();
-				}
+				if(count >= Size) return reset();
+				internal_bitset::shift_left(values, sizeof(values), count);
+				clear_trailing_bits();
 			}
 			return *this;
 		}
@@ -256,13 +663,8 @@ namespace ptl {
 		constexpr
 		auto operator>>=(size_type count) noexcept -> bitset & {
 			if constexpr(Size != 0) {
-				for(size_type i{0}; i < count; ++i) {
-					values[0] = static_cast<unsigned char>(values[0] >> 1);
-					for(size_type j{1}; j < sizeof(values); ++j) {
-						values[j - 1] = static_cast<unsigned char>(values[j - 1] | (values[j] << 7));
-						values[j] = static_cast<unsigned char>(values[j] >> 1);
-					}
-				}
+				if(count >= Size) return reset();
+				internal_bitset::shift_right(values, sizeof(values), count);
 			}
 			return *this;
 		}
@@ -310,7 +712,7 @@ namespace ptl {
 		constexpr
 		auto flip() noexcept -> bitset & {
 			if constexpr(Size != 0) {
-				std::transform(values, values + sizeof(values), values, [](const auto & val) { return static_cast<unsigned char>(~val); });
+				internal_bitset::transform(values, values, sizeof(values), internal_bitset::not_op{});
 				clear_trailing_bits();
 			}
 			return *this;
@@ -330,29 +732,54 @@ namespace ptl {
 		constexpr
 		operator bool() const noexcept { return any(); }
 
+		//! @brief write all bits as binary (base 2) or lower case hexadecimal (base 16) digits, most significant bit first
+		//! @note exactly size() binary or size() / 4 (rounded up) hexadecimal digits are written, converting whole bytes at a time
+		//! @returns {last, std::errc::value_too_large} if [first, last) is too small
+		auto to_chars(char * first, char * last, int base = 2) const noexcept -> std::to_chars_result { //TODO: [C++??] precondition(base == 2 || base == 16);
+			const auto digits{static_cast<std::ptrdiff_t>(base == 2 ? Size : (Size + 3) / 4)};
+			if(last - first < digits) return {last, std::errc::value_too_large};
+			if constexpr(Size != 0) internal_bitset::to_chars(values, Size, first, base);
+			return {first + digits, std::errc{}};
+		}
+		//! @brief parse binary (base 2) or hexadecimal (base 16) digits, the first digit being the most significant one
+		//! @note parsing stops after the last digit or after size() binary or size() / 4 (rounded up) hexadecimal digits, missing leading digits are considered to be zero
+		//! @returns {first, std::errc::invalid_argument} if there is no digit or {end of digits, std::errc::result_out_of_range} if the value exceeds size(), the bitset is not modified in both cases
+		auto from_chars(const char * first, const char * last, int base = 2) noexcept -> std::from_chars_result { //TODO: [C++??] precondition(base == 2 || base == 16);
+			if constexpr(Size == 0) return {first, std::errc::invalid_argument};
+			else {
+				bitset tmp;
+				const auto end{internal_bitset::from_chars(tmp.values, first, last, base == 2 ? Size : (Size + 3) / 4, base)};
+				if(end == first) return {first, std::errc::invalid_argument};
+				if(tmp.values[sizeof(values) - 1] & ~internal_bitset::trailing_bits<Size>) return {end, std::errc::result_out_of_range};
+				*this = tmp;
+				return {end, std::errc{}};
+			}
+		}
+
 		friend
 		auto operator<<(std::ostream & os, const bitset & self) -> std::ostream & {
-			for(size_type i{Size}; i != 0; --i) os << (self.test(i - 1) ? '1' : '0');
+			if constexpr(Size != 0) {
+				std::string buffer(Size, '0');
+				self.to_chars(buffer.data(), buffer.data() + buffer.size());
+				os << buffer;
+			}
 			return os;
 		}
 		friend
 		auto operator>>(std::istream & is,       bitset & self) -> std::istream & {
 			if(const std::istream::sentry s{is}; s) {
-				auto extracted{false};
-				for(size_type i{0}; i < Size; ++i) {
-					if(const auto c{is.get()}; c == '0' || c == '1') {
-						if(!extracted) {
-							extracted = true;
-							self.reset();
-						}
-						self <<= 1;
-						if(c == '1') self.set(0);
-					} else {
-						is.unget();
-						if(!extracted) is.setstate(std::ios::failbit);
+				std::string digits;
+				const auto buf{is.rdbuf()};
+				for(auto c{buf->sgetc()}; digits.size() < Size; c = buf->snextc()) { //only digits are consumed
+					if(std::istream::traits_type::eq_int_type(c, std::istream::traits_type::eof())) {
+						is.setstate(std::ios::eofbit);
 						break;
 					}
+					if(c != '0' && c != '1') break;
+					digits.push_back(static_cast<char>(c));
 				}
+				if(!digits.empty()) self.from_chars(digits.data(), digits.data() + digits.size());
+				else if(Size != 0) is.setstate(std::ios::failbit);
 			}
 			return is;
 		}
@@ -369,7 +796,7 @@ namespace ptl {
 		constexpr
 		auto operator==(const bitset & lhs, const bitset & rhs) noexcept -> bool {
 			if constexpr(Size == 0) return true;
-			else return std::equal(lhs.values, lhs.values + sizeof(values), rhs.values);
+			else return internal_bitset::equal(lhs.values, rhs.values, sizeof(values));
 		}
 		friend
 		constexpr
@@ -382,31 +809,7 @@ namespace std {
 	struct hash<ptl::bitset<Size, Tag>> {
 		auto operator()(const ptl::bitset<Size, Tag> & self) const noexcept -> std::size_t {
 			if constexpr(Size == 0) return 0;
-			else {
-				//fnv1a
-				const std::size_t basis{[&] {
-					if constexpr(constexpr auto bitness{8 * sizeof(std::size_t)}; bitness == 32) {
-						return 2166136261U;
-					} else {
-						static_assert(bitness == 64);
-						return 14695981039346656037ULL;
-					}
-				}()};
-				const std::size_t prime{[&] {
-					if constexpr(constexpr auto bitness{8 * sizeof(std::size_t)}; bitness == 32) {
-						return 16777619U;
-					} else {
-						static_assert(bitness == 64);
-						return 1099511628211ULL;
-					}
-				}()};
-
-				return std::accumulate(self.values, self.values + sizeof(self.values), basis, [&](auto hash, auto value) {
-					hash ^= value;
-					hash *= prime;
-					return hash;
-				});
-			}
+			else return static_cast<std::size_t>(ptl::hash_bytes(self.values, sizeof(self.values)));
 		}
 	};
 
@@ -0,0 +1,380 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <limits>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <utility>
+#include <charconv>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include "hash.hpp"
+#include "bitset.hpp"
+#include "vector.hpp"
+#include "internal/utils.hpp"
+
+namespace ptl {
+	namespace internal_dynamic_bitset {
+		using internal_bitset::bytes;
+
+		//mask of the used bits in the last byte of a bitset with the given number of bits
+		constexpr
+		auto trailing_bits(std::size_t bits) noexcept -> unsigned char { return static_cast<unsigned char>(bits % 8 ? (1 << (bits % 8)) - 1 : 255); }
+
+		//set or clear all bits in [first, last)
+		inline
+		void fill(unsigned char * ptr, std::size_t first, std::size_t last, bool value) noexcept { //TODO: [C++??] precondition(first <= last);
+			if(first == last) return;
+			const auto first_byte{first / 8}, last_byte{(last - 1) / 8};
+			const auto first_mask{static_cast<unsigned char>(255 << (first % 8))}, last_mask{trailing_bits(last)};
+			const auto apply{[&](std::size_t index, unsigned char mask) { ptr[index] = static_cast<unsigned char>(value ? ptr[index] | mask : ptr[index] & ~mask); }};
+			if(first_byte == last_byte) return apply(first_byte, first_mask & last_mask);
+			apply(first_byte, first_mask);
+			std::memset(ptr + first_byte + 1, value ? 255 : 0, last_byte - first_byte - 1);
+			apply(last_byte, last_mask);
+		}
+	}
+
+	//! @brief a sequence of bits whose size is determined at runtime
+	//! @note binary stable layout: {void(*dealloc)(unsigned char *) noexcept, unsigned char * ptr, std::size_t capacity (in bytes), std::size_t size (in bits)}
+	//! @note bit i is stored in bit i % 8 of byte i / 8, all bits of the allocation beyond size() are zero
+	//! @note memory is released with dealloc, which was provided by the binary that allocated it
+	class dynamic_bitset final {
+		class storage_t final {
+			void(*dealloc)(unsigned char *) noexcept{nullptr};
+			unsigned char * ptr{nullptr};
+			std::size_t cap{0}, siz{0};
+		public:
+			storage_t() noexcept =default;
+
+			//whole words simplify loading the last bits
+			static
+			auto round_capacity(std::size_t capacity) noexcept -> std::size_t { return capacity == 0 ? 0 : (std::max(capacity, std::size_t{8}) + 7) / 8 * 8; }
+
+			explicit
+			storage_t(std::size_t capacity) {
+				if(capacity == 0) return;
+				capacity = round_capacity(capacity);
+				ptr = new unsigned char[capacity]{};
+				dealloc = +[](unsigned char * ptr) noexcept { delete[] ptr; };
+				cap = capacity;
+			}
+
+			storage_t(storage_t && other) noexcept : dealloc{std::exchange(other.dealloc, nullptr)}, ptr{std::exchange(other.ptr, nullptr)}, cap{std::exchange(other.cap, 0)}, siz{std::exchange(other.siz, 0)} {}
+			auto operator=(storage_t && other) noexcept -> storage_t & {
+				storage_t tmp{std::move(other)};
+				swap(tmp);
+				return *this;
+			}
+			~storage_t() noexcept { if(dealloc) dealloc(ptr); }
+
+			auto data() const noexcept -> const unsigned char * { return ptr; }
+			auto data()       noexcept ->       unsigned char * { return ptr; }
+
+			auto size() const noexcept -> std::size_t { return siz; }
+			auto capacity() const noexcept -> std::size_t { return cap; }
+
+			void set_size(std::size_t val) noexcept { siz = val; } //TODO: [C++??] precondition(internal_dynamic_bitset::bytes(val) <= capacity());
+
+			void swap(storage_t & other) noexcept {
+				std::swap(dealloc, other.dealloc);
+				std::swap(ptr, other.ptr);
+				std::swap(cap, other.cap);
+				std::swap(siz, other.siz);
+			}
+		} storage;
+
+		auto bytes() const noexcept -> std::size_t { return internal_dynamic_bitset::bytes(size()); }
+
+		//restores the invariant after operations that may have set bits beyond size()
+		void clear_trailing_bits() noexcept { if(!empty()) storage.data()[bytes() - 1] &= internal_dynamic_bitset::trailing_bits(size()); }
+
+		auto grow_capacity(std::size_t required) const -> std::size_t {
+			if(required > max_size()) throw std::length_error{"ptl::dynamic_bitset - exceeding max_size"};
+			return internal_utils::grow_capacity(capacity(), required, max_size());
+		}
+	public:
+		using value_type = bool;
+		using size_type  = std::size_t;
+		class reference final {
+			friend dynamic_bitset;
+
+			dynamic_bitset & self;
+			size_type index;
+
+			reference(dynamic_bitset & self, size_type index) noexcept : self{self}, index{index} {}
+		public:
+			reference(const reference &) =default;
+
+			auto operator=(const reference & other) noexcept -> reference & { return *this = static_cast<bool>(other); }
+
+			auto operator=(bool value) noexcept -> reference & {
+				const auto ptr{self.storage.data() + index / 8};
+				const auto mask{static_cast<unsigned char>(1 << (index % 8))};
+				*ptr = static_cast<unsigned char>(value ? *ptr | mask : *ptr & ~mask);
+				return *this;
+			}
+
+			operator bool() const noexcept { return static_cast<const dynamic_bitset &>(self)[index]; }
+			auto operator~() const noexcept -> bool { return !static_cast<bool>(*this); }
+
+			auto flip() noexcept -> reference & { return *this = !*this; }
+
+			void swap(reference & other) noexcept {
+				const auto lhs{static_cast<bool>(*this)};
+				const auto rhs{static_cast<bool>(other)};
+				if(lhs == rhs) return;
+				*this = rhs;
+				other = lhs;
+			}
+			friend
+			void swap(reference lhs, reference rhs) noexcept { lhs.swap(rhs); }
+		};
+		using const_reference = bool;
+
+		dynamic_bitset() noexcept =default;
+		dynamic_bitset(const dynamic_bitset & other) : storage{other.bytes()} {
+			if(other.empty()) return;
+			std::memcpy(storage.data(), other.storage.data(), other.bytes());
+			storage.set_size(other.size());
+		}
+		dynamic_bitset(dynamic_bitset &&) noexcept =default;
+		auto operator=(const dynamic_bitset & other) -> dynamic_bitset & {
+			if(this == &other) return *this;
+			if(other.bytes() > storage.capacity()) *this = dynamic_bitset{other};
+			else {
+				if(other.bytes() < bytes()) std::memset(storage.data() + other.bytes(), 0, bytes() - other.bytes());
+				if(!other.empty()) std::memcpy(storage.data(), other.storage.data(), other.bytes());
+				storage.set_size(other.size());
+			}
+			return *this;
+		}
+		auto operator=(dynamic_bitset &&) noexcept -> dynamic_bitset & =default;
+		~dynamic_bitset() noexcept =default;
+
+		//! @brief create count bits, all of them set to value
+		explicit
+		dynamic_bitset(size_type count, bool value = false) { resize(count, value); }
+
+		auto operator[](size_type index) const noexcept -> const_reference { return storage.data()[index / 8] & (1 << (index % 8)); } //TODO: [C++??] precondition(index < size());
+		auto operator[](size_type index)       noexcept ->       reference { return {*this, index}; } //TODO: [C++??] precondition(index < size());
+		auto at(size_type index) const -> const_reference {
+			if(index >= size()) throw std::out_of_range{"ptl::dynamic_bitset - invalid index"};
+			return (*this)[index];
+		}
+		auto at(size_type index)       ->       reference {
+			if(index >= size()) throw std::out_of_range{"ptl::dynamic_bitset - invalid index"};
+			return (*this)[index];
+		}
+
+		auto test(size_type index) const -> bool { return at(index); }
+
+		auto all() const noexcept -> bool { return empty() || (internal_bitset::all(storage.data(), bytes() - 1) && storage.data()[bytes() - 1] == internal_dynamic_bitset::trailing_bits(size())); }
+		auto any() const noexcept -> bool { return internal_bitset::any(storage.data(), bytes()); }
+		auto none() const noexcept -> bool { return !any(); }
+
+		//! @returns number of set bits
+		auto count() const noexcept -> size_type { return internal_bitset::count(storage.data(), bytes()); }
+
+		//! @brief find the first set bit
+		//! @returns index of the first set bit or size() if no bit is set
+		auto find_first() const noexcept -> size_type { return std::min(internal_bitset::find_next(storage.data(), bytes(), 0), size()); }
+		//! @brief find the next set bit
+		//! @param[in] index position to search after
+		//! @returns index of the first set bit after index or size() if there is none
+		auto find_next(size_type index) const noexcept -> size_type {
+			if(index + 1 >= size()) return size();
+			return std::min(internal_bitset::find_next(storage.data(), bytes(), index + 1), size());
+		}
+		//! @brief find the last set bit
+		//! @returns index of the last set bit or size() if no bit is set
+		auto find_last() const noexcept -> size_type { return std::min(internal_bitset::find_last(storage.data(), bytes()), size()); }
+
+		//! @brief forward iterator over the indices of all set bits
+		using set_bit_iterator = internal_bitset::set_bit_iterator;
+		//! @brief range of the indices of all set bits in ascending order
+		//! @attention the range is invalidated by modifications of the bitset
+		using set_bit_range = internal_bitset::set_bit_range;
+
+		//! @brief iterate over the indices of all set bits
+		auto set_bits() const noexcept -> set_bit_range { return {data(), size()}; }
+
+		//! @returns underlying bytes, bit i is stored in bit i % 8 of byte i / 8
+		auto data() const noexcept -> const unsigned char * { return storage.data(); }
+
+		auto size() const noexcept -> size_type { return storage.size(); }
+		[[nodiscard]]
+		auto empty() const noexcept -> bool { return size() == 0; }
+		static
+		auto max_size() noexcept -> size_type { return static_cast<size_type>(std::numeric_limits<std::ptrdiff_t>::max()); }
+		//! @returns number of bits that can be stored without reallocation
+		auto capacity() const noexcept -> size_type { return storage.capacity() * 8; }
+
+		void reserve(size_type new_capacity) {
+			if(new_capacity <= capacity()) return;
+			if(new_capacity > max_size()) throw std::length_error{"ptl::dynamic_bitset - exceeding max_size"};
+			storage_t tmp{internal_dynamic_bitset::bytes(new_capacity)};
+			if(!empty()) std::memcpy(tmp.data(), storage.data(), bytes());
+			tmp.set_size(size());
+			storage = std::move(tmp);
+		}
+
+		void resize(size_type count, bool value = false) {
+			const auto old{size()};
+			if(count > capacity()) reserve(grow_capacity(count));
+			if(count > old) internal_dynamic_bitset::fill(storage.data(), old, count, value);
+			else internal_dynamic_bitset::fill(storage.data(), count, old, false);
+			storage.set_size(count);
+		}
+
+		void shrink_to_fit() {
+			if(storage.capacity() == storage_t::round_capacity(bytes())) return;
+			dynamic_bitset tmp{*this};
+			swap(tmp);
+		}
+
+		void clear() noexcept {
+			if(!empty()) std::memset(storage.data(), 0, bytes());
+			storage.set_size(0);
+		}
+
+		void push_back(bool value) {
+			if(size() == capacity()) reserve(grow_capacity(size() + 1));
+			storage.set_size(size() + 1);
+			(*this)[size() - 1] = value;
+		}
+		void pop_back() noexcept { //TODO: [C++??] precondition(!empty());
+			(*this)[size() - 1] = false;
+			storage.set_size(size() - 1);
+		}
+
+		auto operator&=(const dynamic_bitset & other) noexcept -> dynamic_bitset & { //TODO: [C++??] precondition(size() == other.size());
+			internal_bitset::transform(storage.data(), other.storage.data(), bytes(), internal_bitset::and_op{});
+			return *this;
+		}
+		friend
+		auto operator&(dynamic_bitset lhs, const dynamic_bitset & rhs) noexcept -> dynamic_bitset { //TODO: [C++??] precondition(lhs.size() == rhs.size());
+			lhs &= rhs;
+			return lhs;
+		}
+
+		auto operator|=(const dynamic_bitset & other) noexcept -> dynamic_bitset & { //TODO: [C++??] precondition(size() == other.size());
+			internal_bitset::transform(storage.data(), other.storage.data(), bytes(), internal_bitset::or_op{});
+			return *this;
+		}
+		friend
+		auto operator|(dynamic_bitset lhs, const dynamic_bitset & rhs) noexcept -> dynamic_bitset { //TODO: [C++??] precondition(lhs.size() == rhs.size());
+			lhs |= rhs;
+			return lhs;
+		}
+
+		auto operator^=(const dynamic_bitset & other) noexcept -> dynamic_bitset & { //TODO: [C++??] precondition(size() == other.size());
+			internal_bitset::transform(storage.data(), other.storage.data(), bytes(), internal_bitset::xor_op{});
+			return *this;
+		}
+		friend
+		auto operator^(dynamic_bitset lhs, const dynamic_bitset & rhs) noexcept -> dynamic_bitset { //TODO: [C++??] precondition(lhs.size() == rhs.size());
+			lhs ^= rhs;
+			return lhs;
+		}
+
+		auto operator~() const -> dynamic_bitset {
+			auto tmp{*this};
+			tmp.flip();
+			return tmp;
+		}
+
+		auto operator<<=(size_type count) noexcept -> dynamic_bitset & {
+			if(count >= size()) return reset();
+			internal_bitset::shift_left(storage.data(), bytes(), count);
+			clear_trailing_bits();
+			return *this;
+		}
+		friend
+		auto operator<<(dynamic_bitset lhs, size_type rhs) noexcept -> dynamic_bitset {
+			lhs <<= rhs;
+			return lhs;
+		}
+
+		auto operator>>=(size_type count) noexcept -> dynamic_bitset & {
+			if(count >= size()) return reset();
+			internal_bitset::shift_right(storage.data(), bytes(), count);
+			return *this;
+		}
+		friend
+		auto operator>>(dynamic_bitset lhs, size_type rhs) noexcept -> dynamic_bitset {
+			lhs >>= rhs;
+			return lhs;
+		}
+
+		auto set() noexcept -> dynamic_bitset & {
+			internal_dynamic_bitset::fill(storage.data(), 0, size(), true);
+			return *this;
+		}
+		auto set(size_type index, bool value = true) -> dynamic_bitset & {
+			at(index) = value;
+			return *this;
+		}
+
+		auto reset() noexcept -> dynamic_bitset & {
+			if(!empty()) std::memset(storage.data(), 0, bytes());
+			return *this;
+		}
+		auto reset(size_type index) -> dynamic_bitset & { return set(index, false); }
+
+		auto flip() noexcept -> dynamic_bitset & {
+			internal_bitset::transform(storage.data(), storage.data(), bytes(), internal_bitset::not_op{});
+			clear_trailing_bits();
+			return *this;
+		}
+		auto flip(size_type index) -> dynamic_bitset & {
+			at(index).flip();
+			return *this;
+		}
+
+		//! @brief write all bits as binary (base 2) or lower case hexadecimal (base 16) digits, most significant bit first
+		//! @note exactly size() binary or size() / 4 (rounded up) hexadecimal digits are written, converting whole bytes at a time
+		//! @returns {last, std::errc::value_too_large} if [first, last) is too small
+		auto to_chars(char * first, char * last, int base = 2) const noexcept -> std::to_chars_result { //TODO: [C++??] precondition(base == 2 || base == 16);
+			const auto digits{static_cast<std::ptrdiff_t>(base == 2 ? size() : (size() + 3) / 4)};
+			if(last - first < digits) return {last, std::errc::value_too_large};
+			if(!empty()) internal_bitset::to_chars(storage.data(), size(), first, base);
+			return {first + digits, std::errc{}};
+		}
+
+		friend
+		auto operator<<(std::ostream & os, const dynamic_bitset & self) -> std::ostream & {
+			if(self.empty()) return os;
+			std::string buffer(self.size(), '0');
+			self.to_chars(buffer.data(), buffer.data() + buffer.size());
+			return os << buffer;
+		}
+
+		void swap(dynamic_bitset & other) noexcept { storage.swap(other.storage); }
+		friend
+		void swap(dynamic_bitset & lhs, dynamic_bitset & rhs) noexcept { lhs.swap(rhs); }
+
+		friend
+		auto operator==(const dynamic_bitset & lhs, const dynamic_bitset & rhs) noexcept -> bool { return lhs.size() == rhs.size() && internal_bitset::equal(lhs.storage.data(), rhs.storage.data(), lhs.bytes()); }
+		friend
+		auto operator!=(const dynamic_bitset & lhs, const dynamic_bitset & rhs) noexcept -> bool { return !(lhs == rhs); } //TODO: [C++20] remove as implicitly generated
+	};
+	static_assert(sizeof(dynamic_bitset) == 4 * sizeof(void *));
+
+	template<>
+	struct is_trivially_relocatable<dynamic_bitset> : std::true_type {};
+}
+
+namespace std {
+	template<>
+	struct hash<ptl::dynamic_bitset> {
+		auto operator()(const ptl::dynamic_bitset & self) const noexcept -> std::size_t { return static_cast<std::size_t>(ptl::hash_bytes(self.data(), ptl::internal_dynamic_bitset::bytes(self.size()))); }
+	};
+}
@@ -0,0 +1,99 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "internal/utils.hpp"
+#if defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+#endif
+
+namespace ptl {
+	namespace internal_hash {
+		//inputs are always read as little endian => results are independent of the host
+		using internal_utils::load64;
+
+		inline
+		auto load32(const unsigned char * ptr) noexcept -> std::uint64_t { return std::uint64_t{ptr[0]} | std::uint64_t{ptr[1]} << 8 | std::uint64_t{ptr[2]} << 16 | std::uint64_t{ptr[3]} << 24; }
+
+		//1 to 3 bytes
+		inline
+		auto load_small(const unsigned char * ptr, std::size_t size) noexcept -> std::uint64_t { return std::uint64_t{ptr[0]} << 16 | std::uint64_t{ptr[size / 2]} << 8 | ptr[size - 1]; }
+
+		//full 64x64 => 128 bit multiplication, all variants yield identical results
+		inline
+		void multiply(std::uint64_t & lhs, std::uint64_t & rhs) noexcept {
+		#if defined(__SIZEOF_INT128__)
+			__extension__ using uint128_t = unsigned __int128;
+			const auto result{static_cast<uint128_t>(lhs) * rhs};
+			lhs = static_cast<std::uint64_t>(result);
+			rhs = static_cast<std::uint64_t>(result >> 64);
+		#elif defined(_MSC_VER) && defined(_M_X64)
+			lhs = _umul128(lhs, rhs, &rhs);
+		#else
+			const auto lhs_hi{lhs >> 32}, lhs_lo{lhs & 0xFFFFFFFF}, rhs_hi{rhs >> 32}, rhs_lo{rhs & 0xFFFFFFFF};
+			const auto hh{lhs_hi * rhs_hi}, hl{lhs_hi * rhs_lo}, lh{lhs_lo * rhs_hi}, ll{lhs_lo * rhs_lo};
+			const auto mid{(ll >> 32) + (hl & 0xFFFFFFFF) + (lh & 0xFFFFFFFF)};
+			lhs = (mid << 32) | (ll & 0xFFFFFFFF);
+			rhs = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+		#endif
+		}
+
+		inline
+		auto mix(std::uint64_t lhs, std::uint64_t rhs) noexcept -> std::uint64_t {
+			multiply(lhs, rhs);
+			return lhs ^ rhs;
+		}
+
+		inline
+		constexpr
+		std::uint64_t secret[]{0x2d358dccaa6c78a5, 0x8bb84b93962eacc9, 0x4b33a62ed433d4a3, 0x4d5a2da51de1aa47};
+	}
+
+	//! @brief hash a sequence of bytes
+	//! @param[in] ptr start of the sequence
+	//! @param[in] size length of the sequence in bytes
+	//! @param[in] seed value to derive independent hash functions
+	//! @returns 64 bit hash value that is identical for every compiler and platform
+	//! @note the algorithm follows wyhash (final version 4) and processes 16 to 48 bytes per step
+	inline
+	auto hash_bytes(const void * ptr, std::size_t size, std::uint64_t seed = 0) noexcept -> std::uint64_t {
+		auto p{static_cast<const unsigned char *>(ptr)};
+		seed ^= internal_hash::mix(seed ^ internal_hash::secret[0], internal_hash::secret[1]);
+		std::uint64_t a, b;
+		if(size <= 16) {
+			if(size >= 4) {
+				const auto offset{(size >> 3) << 2};
+				a = (internal_hash::load32(p) << 32) | internal_hash::load32(p + offset);
+				b = (internal_hash::load32(p + size - 4) << 32) | internal_hash::load32(p + size - 4 - offset);
+			} else if(size > 0) {
+				a = internal_hash::load_small(p, size);
+				b = 0;
+			} else a = b = 0;
+		} else {
+			auto remaining{size};
+			if(remaining >= 48) { //three independent lanes to hide the latency of the multiplications
+				auto seed1{seed}, seed2{seed};
+				do {
+					seed  = internal_hash::mix(internal_hash::load64(p     ) ^ internal_hash::secret[1], internal_hash::load64(p +  8) ^ seed );
+					seed1 = internal_hash::mix(internal_hash::load64(p + 16) ^ internal_hash::secret[2], internal_hash::load64(p + 24) ^ seed1);
+					seed2 = internal_hash::mix(internal_hash::load64(p + 32) ^ internal_hash::secret[3], internal_hash::load64(p + 40) ^ seed2);
+					p += 48;
+					remaining -= 48;
+				} while(remaining >= 48);
+				seed ^= seed1 ^ seed2;
+			}
+			for(; remaining > 16; remaining -= 16, p += 16) seed = internal_hash::mix(internal_hash::load64(p) ^ internal_hash::secret[1], internal_hash::load64(p + 8) ^ seed);
+			a = internal_hash::load64(p + remaining - 16);
+			b = internal_hash::load64(p + remaining -  8);
+		}
+		a ^= internal_hash::secret[1];
+		b ^= seed;
+		internal_hash::multiply(a, b);
+		return internal_hash::mix(a ^ internal_hash::secret[0] ^ size, b ^ internal_hash::secret[1]);
+	}
+}
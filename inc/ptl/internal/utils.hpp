@@ -0,0 +1,116 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define PTL_INTERNAL_SSE2 //NOTE: not undefined at the end of this header, as it is shared by every header using SIMD
+#endif
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace ptl {
+	//helpers shared by multiple headers
+	namespace internal_utils {
+		constexpr
+		auto is_constant_evaluated() noexcept -> bool { //TODO: [C++20] replace with std::is_constant_evaluated
+		#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+			return __builtin_is_constant_evaluated();
+		#else
+			return true; //no way to detect => always use the portable code path
+		#endif
+		}
+
+		//TODO: [C++20] replace with std::popcount
+		constexpr
+		auto popcount(std::uint64_t value) noexcept -> unsigned {
+		#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<unsigned>(__builtin_popcountll(value));
+		#else
+			#if defined(_MSC_VER) && defined(_M_X64) && defined(__AVX2__)
+			if(!is_constant_evaluated()) return static_cast<unsigned>(_mm_popcnt_u64(value));
+			#endif
+			value = value - ((value >> 1) & 0x5555555555555555);
+			value = (value & 0x3333333333333333) + ((value >> 2) & 0x3333333333333333);
+			value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0F;
+			return static_cast<unsigned>((value * 0x0101010101010101) >> 56);
+		#endif
+		}
+
+		//TODO: [C++20] replace with std::countr_zero
+		constexpr
+		auto countr_zero(std::uint64_t value) noexcept -> unsigned { //TODO: [C++??] precondition(value != 0);
+		#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<unsigned>(__builtin_ctzll(value));
+		#else
+			#if defined(_MSC_VER) && defined(_M_X64)
+			if(!is_constant_evaluated()) {
+				unsigned long index;
+				_BitScanForward64(&index, value);
+				return index;
+			}
+			#endif
+			return popcount((value & (~value + 1)) - 1);
+		#endif
+		}
+
+		//TODO: [C++20] replace with std::countl_zero
+		constexpr
+		auto countl_zero(std::uint64_t value) noexcept -> unsigned { //TODO: [C++??] precondition(value != 0);
+		#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<unsigned>(__builtin_clzll(value));
+		#else
+			#if defined(_MSC_VER) && defined(_M_X64)
+			if(!is_constant_evaluated()) {
+				unsigned long index;
+				_BitScanReverse64(&index, value);
+				return 63 - index;
+			}
+			#endif
+			value |= value >>  1;
+			value |= value >>  2;
+			value |= value >>  4;
+			value |= value >>  8;
+			value |= value >> 16;
+			value |= value >> 32;
+			return 64 - popcount(value);
+		#endif
+		}
+
+		//little endian => the byte order is independent of the host
+		//NOTE: manually unrolled as compilers only fuse these patterns into a single (unaligned) load/store when they are straight-line code
+		constexpr
+		auto load64(const unsigned char * ptr) noexcept -> std::uint64_t {
+			return std::uint64_t{ptr[0]}       | std::uint64_t{ptr[1]} <<  8 | std::uint64_t{ptr[2]} << 16 | std::uint64_t{ptr[3]} << 24
+			     | std::uint64_t{ptr[4]} << 32 | std::uint64_t{ptr[5]} << 40 | std::uint64_t{ptr[6]} << 48 | std::uint64_t{ptr[7]} << 56;
+		}
+
+		constexpr
+		void store64(unsigned char * ptr, std::uint64_t value) noexcept {
+			ptr[0] = static_cast<unsigned char>(value      );
+			ptr[1] = static_cast<unsigned char>(value >>  8);
+			ptr[2] = static_cast<unsigned char>(value >> 16);
+			ptr[3] = static_cast<unsigned char>(value >> 24);
+			ptr[4] = static_cast<unsigned char>(value >> 32);
+			ptr[5] = static_cast<unsigned char>(value >> 40);
+			ptr[6] = static_cast<unsigned char>(value >> 48);
+			ptr[7] = static_cast<unsigned char>(value >> 56);
+		}
+
+		//geometric growth (factor 1.5) => amortized O(1) for repeated appends
+		constexpr
+		auto grow_capacity(std::size_t capacity, std::size_t required, std::size_t max_size) noexcept -> std::size_t { //TODO: [C++??] precondition(required <= max_size);
+			return std::max(required, capacity < max_size - capacity / 2 ? capacity + capacity / 2 : max_size);
+		}
+	}
+}
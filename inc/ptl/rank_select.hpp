@@ -0,0 +1,142 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include "bitset.hpp"
+#include "vector.hpp"
+#include "dynamic_bitset.hpp"
+#include "internal/utils.hpp"
+#if defined(__BMI2__)
+	#include <immintrin.h>
+#endif
+
+namespace ptl {
+	namespace internal_rank_select {
+		constexpr
+		std::size_t word_bits{64},
+		            block_bits{512},       //8 words, ranks relative to the superblock fit into 16 bits
+		            superblock_bits{4096}, //absolute ranks
+		            sample_rate{8192};     //every sample_rate-th set bit records its superblock to narrow down select
+
+		constexpr
+		std::size_t words_per_block{block_bits / word_bits},
+		            blocks_per_superblock{superblock_bits / block_bits};
+
+		//position of the k-th (starting at 0) set bit in value
+		inline
+		auto select(std::uint64_t value, unsigned k) noexcept -> unsigned { //TODO: [C++??] precondition(k < internal_utils::popcount(value));
+		#if defined(__BMI2__)
+			return internal_utils::countr_zero(_pdep_u64(std::uint64_t{1} << k, value));
+		#else
+			//prefix sums of the per-byte popcounts locate the byte, the bit is located within that byte
+			auto counts{value - ((value >> 1) & 0x5555555555555555)};
+			counts = (counts & 0x3333333333333333) + ((counts >> 2) & 0x3333333333333333);
+			counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0F;
+			const auto prefix{counts * 0x0101010101010101}; //byte i contains the number of set bits in bytes [0, i]
+			unsigned byte{0};
+			while(((prefix >> (byte * 8)) & 255) <= k) ++byte;
+			if(byte != 0) k -= static_cast<unsigned>((prefix >> (byte * 8 - 8)) & 255);
+			auto bits{static_cast<unsigned>((value >> (byte * 8)) & 255)};
+			for(; k != 0; --k) bits &= bits - 1;
+			return byte * 8 + internal_utils::countr_zero(bits);
+		#endif
+		}
+	}
+
+	//! @brief auxiliary index answering rank and select queries over the bits of a ptl::bitset or ptl::dynamic_bitset
+	//! @note rank is answered in constant time, select in constant time for evenly distributed bits and logarithmic in the distance between samples otherwise
+	//! @note the index occupies about 4.7% of the indexed bits (absolute ranks per 4096 bits, relative ranks per 512 bits) plus up to 0.8% for samples (one per 8192 set bits)
+	//! @attention the index references the bits and is invalidated by modifying or destroying them
+	class rank_select final {
+		const unsigned char * ptr{nullptr};
+		std::size_t siz{0}, bytes{0};
+		vector<std::uint64_t> superblocks; //number of set bits before each superblock, followed by the total number
+		vector<std::uint16_t> blocks;      //number of set bits before each block within its superblock
+		vector<std::uint64_t> samples;     //superblock containing the (i * sample_rate)-th set bit
+
+		auto word(std::size_t index) const noexcept -> std::uint64_t {
+			const auto offset{index * 8};
+			return internal_bitset::load(ptr + offset, bytes - offset);
+		}
+	public:
+		rank_select() noexcept =default;
+
+		//! @brief index bits in the layout of ptl::bitset (bit i is stored in bit i % 8 of byte i / 8)
+		//! @param[in] data bytes storing the bits
+		//! @param[in] size number of bits
+		//! @attention bits in the last byte beyond size must be zero
+		rank_select(const unsigned char * data, std::size_t size) : ptr{data}, siz{size}, bytes{size / 8 + (size % 8 ? 1 : 0)} {
+			using namespace internal_rank_select;
+			const auto words{(size + word_bits - 1) / word_bits};
+			superblocks.reserve((size + superblock_bits - 1) / superblock_bits + 1);
+			blocks.reserve((size + block_bits - 1) / block_bits);
+			std::uint64_t total{0}, relative{0};
+			for(std::size_t i{0}; i < words; ++i) {
+				if(i % (superblock_bits / word_bits) == 0) {
+					superblocks.push_back(total);
+					relative = 0;
+				}
+				if(i % words_per_block == 0) blocks.push_back(static_cast<std::uint16_t>(relative));
+				const auto count{internal_utils::popcount(word(i))};
+				total += count;
+				relative += count;
+			}
+			superblocks.push_back(total);
+
+			samples.reserve(static_cast<std::size_t>(total / sample_rate + 1));
+			for(std::size_t i{0}; i + 1 < superblocks.size(); ++i)
+				while(samples.size() * sample_rate < superblocks[i + 1])
+					samples.push_back(i);
+		}
+		template<std::size_t Size, typename Tag>
+		explicit
+		rank_select(const bitset<Size, Tag> & bits) : rank_select(bits.data(), bits.size()) {}
+		explicit
+		rank_select(const dynamic_bitset & bits) : rank_select(bits.data(), bits.size()) {}
+
+		//! @returns number of indexed bits
+		auto size() const noexcept -> std::size_t { return siz; }
+		//! @returns number of set bits
+		auto count() const noexcept -> std::size_t { return superblocks.empty() ? 0 : static_cast<std::size_t>(superblocks.back()); }
+
+		//! @returns number of set bits before index
+		auto rank(std::size_t index) const noexcept -> std::size_t { //TODO: [C++??] precondition(index <= size());
+			using namespace internal_rank_select;
+			if(index == siz) return count();
+			auto result{superblocks[index / superblock_bits] + blocks[index / block_bits]};
+			const auto last{index / word_bits};
+			for(auto i{index / block_bits * words_per_block}; i < last; ++i) result += internal_utils::popcount(word(i));
+			result += internal_utils::popcount(word(last) & ((std::uint64_t{1} << (index % word_bits)) - 1));
+			return static_cast<std::size_t>(result);
+		}
+
+		//! @returns index of the k-th (starting at 0) set bit, size() if there are less than k + 1 set bits
+		auto select(std::size_t k) const noexcept -> std::size_t {
+			using namespace internal_rank_select;
+			if(k >= count()) return siz;
+			const auto sample{k / sample_rate};
+			const auto first{superblocks.begin() + static_cast<std::ptrdiff_t>(samples[sample])};
+			const auto last{sample + 1 < samples.size() ? superblocks.begin() + static_cast<std::ptrdiff_t>(samples[sample + 1] + 1) : superblocks.end()};
+			const auto superblock{static_cast<std::size_t>(std::upper_bound(first, last, k) - superblocks.begin() - 1)};
+			auto remaining{k - static_cast<std::size_t>(superblocks[superblock])};
+
+			auto block{superblock * blocks_per_superblock};
+			for(const auto end{std::min(block + blocks_per_superblock, blocks.size())}; block + 1 < end && blocks[block + 1] <= remaining;) ++block;
+			remaining -= blocks[block];
+
+			for(auto i{block * words_per_block};; ++i) {
+				const auto value{word(i)};
+				if(const auto count{internal_utils::popcount(value)}; remaining < count) return i * word_bits + internal_rank_select::select(value, static_cast<unsigned>(remaining));
+				else remaining -= count;
+			}
+		}
+
+		//! @returns number of bytes occupied by the index
+		auto memory_usage() const noexcept -> std::size_t { return superblocks.capacity() * sizeof(std::uint64_t) + blocks.capacity() * sizeof(std::uint16_t) + samples.capacity() * sizeof(std::uint64_t); }
+	};
+}
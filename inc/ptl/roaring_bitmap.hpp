@@ -0,0 +1,1009 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <initializer_list>
+#include "bitset.hpp"
+#include "vector.hpp"
+#include "dynamic_bitset.hpp"
+#include "internal/utils.hpp"
+
+namespace ptl {
+	class roaring_bitmap;
+
+	namespace internal_roaring_bitmap {
+		enum class kind : std::uint8_t { array, bitmap, run };
+
+		constexpr
+		std::uint32_t chunk_size{65536}; //values sharing their upper 16 bits are stored in the same container
+
+		constexpr
+		std::size_t bitmap_bytes{chunk_size / 8},
+		            max_array_cardinality{4096}; //arrays up to this size are never larger than a bitmap
+
+		//all 16-bit values are stored in little endian order, allowing serialized data to be used as is on any host
+		inline
+		auto load16(const unsigned char * ptr) noexcept -> std::uint16_t { return static_cast<std::uint16_t>(ptr[0] | ptr[1] << 8); }
+
+		inline
+		void store16(unsigned char * ptr, std::uint16_t value) noexcept {
+			ptr[0] = static_cast<unsigned char>(value);
+			ptr[1] = static_cast<unsigned char>(value >> 8);
+		}
+
+		inline
+		auto load32(const unsigned char * ptr) noexcept -> std::uint32_t { return std::uint32_t{load16(ptr)} | std::uint32_t{load16(ptr + 2)} << 16; }
+
+		inline
+		void store32(unsigned char * ptr, std::uint32_t value) noexcept {
+			store16(ptr, static_cast<std::uint16_t>(value));
+			store16(ptr + 2, static_cast<std::uint16_t>(value >> 16));
+		}
+
+		//read-only access to a container, either in memory or inside serialized data
+		struct container_ref final {
+			std::uint16_t key;
+			kind type;
+			std::uint32_t cardinality;
+			const unsigned char * data; //array: sorted values, bitmap: bytes of a ptl::bitset<65536>, run: pairs {first, last - first}
+			std::size_t size;           //number of 16-bit elements in data
+
+			auto value(std::size_t index) const noexcept -> std::uint16_t { return load16(data + index * 2); }
+
+			auto runs() const noexcept -> std::size_t { return size / 2; }
+			auto run_first(std::size_t index) const noexcept -> std::uint32_t { return load16(data + index * 4); }
+			auto run_last(std::size_t index) const noexcept -> std::uint32_t { return run_first(index) + load16(data + index * 4 + 2); }
+
+			//index of the first array value not less than value
+			auto lower_bound(std::uint32_t value) const noexcept -> std::size_t {
+				std::size_t first{0};
+				for(auto count{size}; count != 0;) {
+					const auto step{count / 2};
+					if(this->value(first + step) < value) {
+						first += step + 1;
+						count -= step + 1;
+					} else count = step;
+				}
+				return first;
+			}
+
+			//index of the first run starting after value
+			auto upper_run(std::uint32_t value) const noexcept -> std::size_t {
+				std::size_t first{0};
+				for(auto count{runs()}; count != 0;) {
+					const auto step{count / 2};
+					if(run_first(first + step) <= value) {
+						first += step + 1;
+						count -= step + 1;
+					} else count = step;
+				}
+				return first;
+			}
+
+			auto contains(std::uint32_t value) const noexcept -> bool {
+				switch(type) {
+					case kind::array: {
+						const auto index{lower_bound(value)};
+						return index < size && this->value(index) == value;
+					}
+					case kind::bitmap: return data[value / 8] & (1 << (value % 8));
+					case kind::run: {
+						const auto index{upper_run(value)};
+						return index != 0 && value <= run_last(index - 1);
+					}
+				}
+				return false;
+			}
+
+			//smallest contained value not less than value, chunk_size if there is none
+			auto next(std::uint32_t value) const noexcept -> std::uint32_t {
+				if(value >= chunk_size) return chunk_size;
+				switch(type) {
+					case kind::array: {
+						const auto index{lower_bound(value)};
+						return index < size ? this->value(index) : chunk_size;
+					}
+					case kind::bitmap: return static_cast<std::uint32_t>(internal_bitset::find_next(data, bitmap_bytes, value));
+					case kind::run: {
+						const auto index{upper_run(value)};
+						if(index != 0 && value <= run_last(index - 1)) return value;
+						return index < runs() ? run_first(index) : chunk_size;
+					}
+				}
+				return chunk_size;
+			}
+		};
+
+		struct container final {
+			std::uint16_t key{0};
+			kind type{kind::array};
+			std::uint32_t cardinality{0};
+			vector<unsigned char> data;
+
+			auto ref() const noexcept -> container_ref { return {key, type, cardinality, data.data(), data.size() / 2}; }
+		};
+
+		inline
+		auto copy(const container_ref & c) -> container { return {c.key, c.type, c.cardinality, vector<unsigned char>(c.data, c.data + c.size * 2)}; }
+
+		template<typename Func>
+		void for_each_value(const container_ref & c, Func func) {
+			switch(c.type) {
+				case kind::array:
+					for(std::size_t i{0}; i < c.size; ++i) func(c.value(i));
+					break;
+				case kind::bitmap:
+					for(std::size_t i{0}; i < bitmap_bytes; i += 8)
+						for(auto word{internal_bitset::load(c.data + i)}; word; word &= word - 1)
+							func(static_cast<std::uint16_t>(i * 8 + internal_utils::countr_zero(word)));
+					break;
+				case kind::run:
+					for(std::size_t i{0}; i < c.runs(); ++i)
+						for(auto value{c.run_first(i)}, last{c.run_last(i)}; value <= last; ++value)
+							func(static_cast<std::uint16_t>(value));
+					break;
+			}
+		}
+
+		//calls func(first, last) for every maximal range of consecutive values
+		template<typename Func>
+		void for_each_run(const container_ref & c, Func func) {
+			switch(c.type) {
+				case kind::array:
+					for(std::size_t i{0}; i < c.size;) {
+						const std::uint32_t first{c.value(i)};
+						auto last{first};
+						for(++i; i < c.size && c.value(i) == last + 1; ++i) ++last;
+						func(first, last);
+					}
+					break;
+				case kind::bitmap: {
+					std::uint32_t first{0};
+					auto open{false};
+					for(std::size_t i{0}; i < bitmap_bytes; i += 8) { //alternately search for the next set and the next unset bit
+						const auto word{internal_bitset::load(c.data + i)};
+						const auto base{static_cast<std::uint32_t>(i * 8)};
+						for(unsigned pos{0}; pos < 64;) {
+							const auto remaining{(open ? ~word : word) >> pos};
+							if(!remaining) break;
+							pos += internal_utils::countr_zero(remaining);
+							if(open) func(first, base + pos - 1);
+							else first = base + pos;
+							open = !open;
+						}
+					}
+					if(open) func(first, chunk_size - 1);
+				} break;
+				case kind::run:
+					for(std::size_t i{0}; i < c.runs(); ++i) func(c.run_first(i), c.run_last(i));
+					break;
+			}
+		}
+
+		inline
+		auto count_runs(const container_ref & c) noexcept -> std::size_t {
+			switch(c.type) {
+				case kind::array: {
+					std::size_t result{c.size != 0};
+					for(std::size_t i{1}; i < c.size; ++i) result += c.value(i) != c.value(i - 1) + 1;
+					return result;
+				}
+				case kind::bitmap: {
+					std::size_t result{0};
+					std::uint64_t carry{0};
+					for(std::size_t i{0}; i < bitmap_bytes; i += 8) { //a run starts at every set bit whose predecessor is unset
+						const auto word{internal_bitset::load(c.data + i)};
+						result += internal_utils::popcount(word & ~((word << 1) | carry));
+						carry = word >> 63;
+					}
+					return result;
+				}
+				case kind::run: return c.runs();
+			}
+			return 0;
+		}
+
+		//set all values of c in bitmap
+		inline
+		void or_into(unsigned char * bitmap, const container_ref & c) noexcept {
+			switch(c.type) {
+				case kind::array:
+					for(std::size_t i{0}; i < c.size; ++i) {
+						const auto value{c.value(i)};
+						bitmap[value / 8] = static_cast<unsigned char>(bitmap[value / 8] | (1 << (value % 8)));
+					}
+					break;
+				case kind::bitmap: internal_bitset::transform(bitmap, c.data, bitmap_bytes, internal_bitset::or_op{}); break;
+				case kind::run:
+					for(std::size_t i{0}; i < c.runs(); ++i) internal_dynamic_bitset::fill(bitmap, c.run_first(i), c.run_last(i) + 1, true);
+					break;
+			}
+		}
+
+		//clear all values of c in bitmap
+		inline
+		void andnot_into(unsigned char * bitmap, const container_ref & c) noexcept {
+			switch(c.type) {
+				case kind::array:
+					for(std::size_t i{0}; i < c.size; ++i) {
+						const auto value{c.value(i)};
+						bitmap[value / 8] = static_cast<unsigned char>(bitmap[value / 8] & ~(1 << (value % 8)));
+					}
+					break;
+				case kind::bitmap:
+					for(std::size_t i{0}; i < bitmap_bytes; i += 8) internal_bitset::store(bitmap + i, internal_bitset::load(bitmap + i) & ~internal_bitset::load(c.data + i));
+					break;
+				case kind::run:
+					for(std::size_t i{0}; i < c.runs(); ++i) internal_dynamic_bitset::fill(bitmap, c.run_first(i), c.run_last(i) + 1, false);
+					break;
+			}
+		}
+
+		//clear all values of bitmap that are not contained in c (no arrays)
+		inline
+		void and_into(unsigned char * bitmap, const container_ref & c) noexcept {
+			if(c.type == kind::bitmap) return internal_bitset::transform(bitmap, c.data, bitmap_bytes, internal_bitset::and_op{});
+			std::uint32_t first{0};
+			for(std::size_t i{0}; i < c.runs(); ++i) { //clear the gaps between the runs
+				internal_dynamic_bitset::fill(bitmap, first, c.run_first(i), false);
+				first = c.run_last(i) + 1;
+			}
+			internal_dynamic_bitset::fill(bitmap, first, chunk_size, false);
+		}
+
+		inline
+		auto convert(const container_ref & c, kind type, std::size_t runs) -> vector<unsigned char> {
+			vector<unsigned char> result;
+			switch(type) {
+				case kind::array: {
+					result.resize_for_overwrite(c.cardinality * std::size_t{2});
+					auto out{result.data()};
+					for_each_value(c, [&](std::uint16_t value) {
+						store16(out, value);
+						out += 2;
+					});
+				} break;
+				case kind::bitmap:
+					result.resize(bitmap_bytes);
+					or_into(result.data(), c);
+					break;
+				case kind::run: {
+					result.resize_for_overwrite(runs * 4);
+					auto out{result.data()};
+					for_each_run(c, [&](std::uint32_t first, std::uint32_t last) {
+						store16(out, static_cast<std::uint16_t>(first));
+						store16(out + 2, static_cast<std::uint16_t>(last - first));
+						out += 4;
+					});
+				} break;
+			}
+			return result;
+		}
+
+		//switch to the smallest representation
+		inline
+		void optimize(container & c) {
+			const auto ref{c.ref()};
+			const auto runs{count_runs(ref)};
+			auto best{kind::bitmap};
+			auto best_bytes{bitmap_bytes};
+			if(ref.cardinality <= max_array_cardinality) {
+				best = kind::array;
+				best_bytes = ref.cardinality * std::size_t{2};
+			}
+			if(runs * 4 < best_bytes) best = kind::run;
+			if(best == c.type) return;
+			c.data = convert(ref, best, runs);
+			c.type = best;
+		}
+
+		inline
+		auto make_bitmap(std::uint16_t key, vector<unsigned char> && bitmap) -> container {
+			const auto cardinality{static_cast<std::uint32_t>(internal_bitset::count(bitmap.data(), bitmap_bytes))};
+			container result{key, kind::bitmap, cardinality, std::move(bitmap)};
+			optimize(result);
+			return result;
+		}
+
+		//results are assembled on the stack before being copied into a container of the exact size, as most of them are small or even empty
+		constexpr
+		std::size_t max_output_bytes{bitmap_bytes};
+
+		inline
+		auto make_container(std::uint16_t key, kind type, std::uint32_t cardinality, const unsigned char * first, const unsigned char * last) -> container {
+			container result{key, type, cardinality, vector<unsigned char>(first, last)};
+			optimize(result);
+			return result;
+		}
+
+		//iterates the runs of an array or run container
+		class run_cursor final {
+			const container_ref c; //copied, as stores through unsigned char * could otherwise alias it
+			std::size_t index{0};
+		public:
+			std::uint32_t first{0}, last{0};
+			bool valid{true};
+
+			run_cursor(const container_ref & c) noexcept : c{c} { advance(); }
+
+			void advance() noexcept {
+				if(c.type == kind::run) {
+					if(index == c.runs()) valid = false;
+					else {
+						first = c.run_first(index);
+						last = c.run_last(index++);
+					}
+				} else {
+					if(index == c.size) valid = false;
+					else {
+						first = last = c.value(index);
+						for(++index; index < c.size && c.value(index) == last + 1; ++index) ++last;
+					}
+				}
+			}
+		};
+
+		//true if the runs of two array or run containers can be combined without materializing any bitmap
+		inline
+		auto sweepable(const container_ref & lhs, const container_ref & rhs) noexcept -> bool {
+			const auto bound{[](const container_ref & c) { return c.type == kind::run ? c.runs() : c.size; }};
+			return lhs.type != kind::bitmap && rhs.type != kind::bitmap && (bound(lhs) + bound(rhs)) * 4 <= max_output_bytes;
+		}
+
+		template<typename Sweep>
+		auto sweep_runs(const container_ref & lhs, const container_ref & rhs, Sweep sweep) -> container { //TODO: [C++??] precondition(sweepable(lhs, rhs));
+			unsigned char buffer[max_output_bytes];
+			auto out{buffer};
+			std::uint32_t cardinality{0};
+			run_cursor l{lhs}, r{rhs};
+			sweep(l, r, [&](std::uint32_t first, std::uint32_t last) {
+				store16(out, static_cast<std::uint16_t>(first));
+				store16(out + 2, static_cast<std::uint16_t>(last - first));
+				out += 4;
+				cardinality += last - first + 1;
+			});
+			return make_container(lhs.key, kind::run, cardinality, buffer, out);
+		}
+
+		template<typename Predicate>
+		auto filter(const container_ref & array, Predicate pred) -> container {
+			unsigned char buffer[max_output_bytes];
+			auto out{buffer};
+			for(std::size_t i{0}, size{array.size}; i < size; ++i) {
+				const auto value{array.value(i)};
+				store16(out, value);
+				out += pred(value) ? 2 : 0;
+			}
+			return make_container(array.key, kind::array, static_cast<std::uint32_t>((out - buffer) / 2), buffer, out);
+		}
+
+		//binary searching the values of a small array beats a linear sweep over a much larger container
+		inline
+		auto skewed(const container_ref & array, const container_ref & other) noexcept -> bool { return array.type == kind::array && (other.type == kind::bitmap || array.size * 32 < other.size); }
+
+		inline
+		auto unite_arrays(const container_ref & lhs, const container_ref & rhs) -> container { //TODO: [C++??] precondition(lhs.size + rhs.size <= max_array_cardinality);
+			unsigned char buffer[max_output_bytes];
+			auto out{buffer};
+			const container_ref l{lhs}, r{rhs};
+			for(std::size_t i{0}, j{0}; i < l.size || j < r.size; out += 2) { //branchless, as the comparisons are unpredictable
+				const std::uint32_t a{i < l.size ? l.value(i) : chunk_size}, b{j < r.size ? r.value(j) : chunk_size};
+				store16(out, static_cast<std::uint16_t>(std::min(a, b)));
+				i += a <= b;
+				j += b <= a;
+			}
+			return make_container(l.key, kind::array, static_cast<std::uint32_t>((out - buffer) / 2), buffer, out);
+		}
+
+	#if defined(PTL_INTERNAL_SSE2)
+		//marks the values of the block of 8 values at lhs that are contained in the block of 8 values at rhs (2 bits per value)
+		inline
+		auto match_block(const unsigned char * lhs, const unsigned char * rhs) noexcept -> unsigned {
+			const auto block{_mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs))};
+			auto other{_mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs))};
+			auto equal{_mm_cmpeq_epi16(block, other)};
+			for(auto i{0}; i < 7; ++i) { //compare against all rotations of the other block
+				other = _mm_or_si128(_mm_srli_si128(other, 2), _mm_slli_si128(other, 14));
+				equal = _mm_or_si128(equal, _mm_cmpeq_epi16(block, other));
+			}
+			return static_cast<unsigned>(_mm_movemask_epi8(equal));
+		}
+	#endif
+
+		inline
+		auto intersect_arrays(const container_ref & lhs, const container_ref & rhs) -> container {
+			unsigned char buffer[max_output_bytes];
+			auto out{buffer};
+			const container_ref l{lhs}, r{rhs};
+			std::size_t i{0}, j{0};
+		#if defined(PTL_INTERNAL_SSE2)
+			//compare blocks of 8 values each, advancing the block(s) with the smaller maximum
+			while(i + 8 <= l.size && j + 8 <= r.size) {
+				for(auto mask{match_block(l.data + i * 2, r.data + j * 2)}; mask; mask &= mask - 1, mask &= mask - 1) {
+					store16(out, l.value(i + internal_utils::countr_zero(mask) / 2));
+					out += 2;
+				}
+				const auto l_max{l.value(i + 7)}, r_max{r.value(j + 7)};
+				i += l_max <= r_max ? 8 : 0;
+				j += r_max <= l_max ? 8 : 0;
+			}
+		#endif
+			while(i < l.size && j < r.size) { //branchless, as the comparisons are unpredictable
+				const auto a{l.value(i)}, b{r.value(j)};
+				store16(out, a);
+				out += a == b ? 2 : 0;
+				i += a <= b;
+				j += b <= a;
+			}
+			return make_container(l.key, kind::array, static_cast<std::uint32_t>((out - buffer) / 2), buffer, out);
+		}
+
+		inline
+		auto subtract_arrays(const container_ref & lhs, const container_ref & rhs) -> container {
+			unsigned char buffer[max_output_bytes];
+			auto out{buffer};
+			const container_ref l{lhs}, r{rhs};
+			std::size_t i{0}, j{0};
+			unsigned removed{0}; //values of the block at i matched by previous blocks of rhs (2 bits per value)
+		#if defined(PTL_INTERNAL_SSE2)
+			while(i + 8 <= l.size && j + 8 <= r.size) {
+				removed |= match_block(l.data + i * 2, r.data + j * 2);
+				const auto l_max{l.value(i + 7)}, r_max{r.value(j + 7)};
+				j += r_max <= l_max ? 8 : 0;
+				if(l_max > r_max) continue;
+				for(auto mask{~removed & 0xFFFF}; mask; mask &= mask - 1, mask &= mask - 1) {
+					store16(out, l.value(i + internal_utils::countr_zero(mask) / 2));
+					out += 2;
+				}
+				i += 8;
+				removed = 0;
+			}
+		#endif
+			for(const auto base{i}; i < l.size;) { //branchless, as the comparisons are unpredictable
+				const std::uint32_t a{l.value(i)}, b{j < r.size ? r.value(j) : chunk_size};
+				const auto matched{i - base < 8 && (removed >> ((i - base) * 2)) & 1};
+				store16(out, static_cast<std::uint16_t>(a));
+				out += a < b && !matched ? 2 : 0;
+				i += a <= b;
+				j += b <= a;
+			}
+			return make_container(l.key, kind::array, static_cast<std::uint32_t>((out - buffer) / 2), buffer, out);
+		}
+
+		inline
+		auto intersect(const container_ref & lhs, const container_ref & rhs) -> container {
+			if(skewed(lhs, rhs)) return filter(lhs, [&](std::uint16_t value) { return rhs.contains(value); });
+			if(skewed(rhs, lhs)) return filter(rhs, [&](std::uint16_t value) { return lhs.contains(value); });
+			if(lhs.type == kind::array && rhs.type == kind::array) return intersect_arrays(lhs, rhs);
+			if(sweepable(lhs, rhs))
+				return sweep_runs(lhs, rhs, [](run_cursor & l, run_cursor & r, auto emit) {
+					while(l.valid && r.valid) {
+						if(const auto first{std::max(l.first, r.first)}, last{std::min(l.last, r.last)}; first <= last) emit(first, last);
+						if(l.last < r.last) l.advance();
+						else r.advance();
+					}
+				});
+			//the result of an array is a subset of it, and and_into takes no arrays
+			if(lhs.type == kind::array) return filter(lhs, [&](std::uint16_t value) { return rhs.contains(value); });
+			if(rhs.type == kind::array) return filter(rhs, [&](std::uint16_t value) { return lhs.contains(value); });
+			auto bitmap{lhs.type == kind::bitmap ? vector<unsigned char>(lhs.data, lhs.data + bitmap_bytes) : convert(lhs, kind::bitmap, 0)};
+			and_into(bitmap.data(), rhs);
+			return make_bitmap(lhs.key, std::move(bitmap));
+		}
+
+		inline
+		auto unite(const container_ref & lhs, const container_ref & rhs) -> container {
+			if(lhs.type == kind::array && rhs.type == kind::array && lhs.size + rhs.size <= max_array_cardinality) return unite_arrays(lhs, rhs);
+			if(sweepable(lhs, rhs))
+				return sweep_runs(lhs, rhs, [](run_cursor & l, run_cursor & r, auto emit) {
+					std::uint32_t first{0}, last{0};
+					auto open{false};
+					while(l.valid || r.valid) {
+						auto & next{!r.valid || (l.valid && l.first <= r.first) ? l : r};
+						if(open && next.first <= last + 1) last = std::max(last, next.last);
+						else {
+							if(open) emit(first, last);
+							first = next.first;
+							last = next.last;
+							open = true;
+						}
+						next.advance();
+					}
+					if(open) emit(first, last);
+				});
+			auto bitmap{convert(lhs, kind::bitmap, 0)};
+			or_into(bitmap.data(), rhs);
+			return make_bitmap(lhs.key, std::move(bitmap));
+		}
+
+		inline
+		auto subtract(const container_ref & lhs, const container_ref & rhs) -> container {
+			if(skewed(lhs, rhs)) return filter(lhs, [&](std::uint16_t value) { return !rhs.contains(value); });
+			if(lhs.type == kind::array && rhs.type == kind::array) return subtract_arrays(lhs, rhs);
+			if(sweepable(lhs, rhs))
+				return sweep_runs(lhs, rhs, [](run_cursor & l, run_cursor & r, auto emit) {
+					for(; l.valid; l.advance()) {
+						auto first{l.first};
+						const auto last{l.last};
+						while(r.valid && r.last < first) r.advance();
+						for(; r.valid && r.first <= last; r.advance()) {
+							if(r.first > first) emit(first, r.first - 1);
+							if(r.last >= last) { //may overlap the next run of l as well
+								first = last + 1;
+								break;
+							}
+							first = r.last + 1;
+						}
+						if(first <= last) emit(first, last);
+					}
+				});
+			auto bitmap{convert(lhs, kind::bitmap, 0)};
+			andnot_into(bitmap.data(), rhs);
+			return make_bitmap(lhs.key, std::move(bitmap));
+		}
+
+		inline
+		auto equal(const container_ref & lhs, const container_ref & rhs) -> bool {
+			if(lhs.key != rhs.key || lhs.cardinality != rhs.cardinality) return false;
+			if(lhs.type == rhs.type) return lhs.size == rhs.size && std::memcmp(lhs.data, rhs.data, lhs.size * 2) == 0;
+			return convert(lhs, kind::bitmap, 0) == convert(rhs, kind::bitmap, 0);
+		}
+
+		//serialized format: header, descriptors, payloads (all values little endian)
+		constexpr
+		unsigned char magic[]{'P', 'T', 'L', 'R'};
+
+		constexpr
+		std::size_t header_size{8},      //magic, number of containers (32 bit)
+		            descriptor_size{16}; //key (16 bit), kind (8 bit), reserved (8 bit), cardinality (32 bit), number of 16-bit elements (32 bit), offset of payload from the start of the data (32 bit)
+
+		//merges the containers of two bitmaps, keeping unmatched containers as requested
+		struct algorithms final {
+			template<typename Lhs, typename Rhs, typename Op>
+			static
+			auto combine(const Lhs & lhs, const Rhs & rhs, bool keep_lhs, bool keep_rhs, Op op) -> vector<container> {
+				const auto lhs_count{lhs.container_count()}, rhs_count{rhs.container_count()};
+				vector<container> result;
+				result.reserve(keep_lhs ? lhs_count + (keep_rhs ? rhs_count : 0) : keep_rhs ? rhs_count : std::min(lhs_count, rhs_count));
+				std::size_t i{0}, j{0};
+				while(i < lhs_count || j < rhs_count) {
+					const std::uint32_t l{i < lhs_count ? lhs.container_at(i).key : chunk_size}, r{j < rhs_count ? rhs.container_at(j).key : chunk_size};
+					if(l < r) {
+						if(keep_lhs) result.push_back(copy(lhs.container_at(i)));
+						++i;
+					} else if(r < l) {
+						if(keep_rhs) result.push_back(copy(rhs.container_at(j)));
+						++j;
+					} else {
+						if(auto c{op(lhs.container_at(i), rhs.container_at(j))}; c.cardinality != 0) result.push_back(std::move(c));
+						++i;
+						++j;
+					}
+				}
+				return result;
+			}
+
+			template<typename Lhs, typename Rhs>
+			static
+			auto set_intersection(const Lhs & lhs, const Rhs & rhs) -> roaring_bitmap;
+			template<typename Lhs, typename Rhs>
+			static
+			auto set_union(const Lhs & lhs, const Rhs & rhs) -> roaring_bitmap;
+			template<typename Lhs, typename Rhs>
+			static
+			auto set_difference(const Lhs & lhs, const Rhs & rhs) -> roaring_bitmap;
+
+			template<typename Bitmap>
+			static
+			auto find(const Bitmap & self, std::uint16_t key) noexcept -> std::size_t {
+				std::size_t first{0};
+				for(auto count{self.container_count()}; count != 0;) {
+					const auto step{count / 2};
+					if(self.container_at(first + step).key < key) {
+						first += step + 1;
+						count -= step + 1;
+					} else count = step;
+				}
+				return first;
+			}
+
+			template<typename Bitmap>
+			static
+			auto contains(const Bitmap & self, std::uint32_t value) noexcept -> bool {
+				const auto key{static_cast<std::uint16_t>(value >> 16)};
+				const auto index{find(self, key)};
+				return index < self.container_count() && self.container_at(index).key == key && self.container_at(index).contains(value & 0xFFFF);
+			}
+
+			template<typename Bitmap>
+			static
+			auto cardinality(const Bitmap & self) noexcept -> std::uint64_t {
+				std::uint64_t result{0};
+				for(std::size_t i{0}; i < self.container_count(); ++i) result += self.container_at(i).cardinality;
+				return result;
+			}
+		};
+	}
+
+	//! @brief read-only access to a serialized ptl::roaring_bitmap without decoding or copying it
+	//! @note suitable for memory-mapped files, the data may be located at any address
+	//! @attention the view references the data and is invalidated by modifying or releasing it
+	class roaring_view final {
+		friend roaring_bitmap;
+		friend internal_roaring_bitmap::algorithms;
+
+		const unsigned char * ptr{nullptr};
+		std::size_t count{0};
+
+		auto container_count() const noexcept -> std::size_t { return count; }
+		auto container_at(std::size_t index) const noexcept -> internal_roaring_bitmap::container_ref {
+			using namespace internal_roaring_bitmap;
+			const auto descriptor{ptr + header_size + index * descriptor_size};
+			return {load16(descriptor), static_cast<kind>(descriptor[2]), load32(descriptor + 4), ptr + load32(descriptor + 12), load32(descriptor + 8)};
+		}
+	public:
+		roaring_view() noexcept =default;
+
+		//! @param[in] data result of roaring_bitmap::serialize
+		//! @param[in] size number of bytes in data
+		//! @throws std::invalid_argument if data is not a valid serialized roaring_bitmap
+		//! @note validation inspects every container (linear in size) but copies no values
+		roaring_view(const unsigned char * data, std::size_t size) : ptr{data} {
+			using namespace internal_roaring_bitmap;
+			const auto fail{[] { throw std::invalid_argument{"ptl::roaring_view - invalid data"}; }};
+			if(size < header_size || std::memcmp(data, magic, sizeof(magic)) != 0) fail();
+			count = load32(data + 4);
+			if(count > chunk_size || (size - header_size) / descriptor_size < count) fail();
+			for(std::size_t i{0}; i < count; ++i) {
+				const auto descriptor{data + header_size + i * descriptor_size};
+				if(descriptor[2] > static_cast<unsigned char>(kind::run) || descriptor[3] != 0) fail();
+				if(const std::size_t offset{load32(descriptor + 12)}, elements{load32(descriptor + 8)}; offset > size || (size - offset) / 2 < elements) fail();
+				const auto c{container_at(i)};
+				if(c.cardinality == 0 || c.cardinality > chunk_size || (i != 0 && container_at(i - 1).key >= c.key)) fail();
+				switch(c.type) { //operations rely on the cardinality and on sorted values
+					case kind::array:
+						if(c.size != c.cardinality || c.size > max_array_cardinality) fail();
+						for(std::size_t j{1}; j < c.size; ++j)
+							if(c.value(j - 1) >= c.value(j))
+								fail();
+						break;
+					case kind::bitmap: if(c.size != bitmap_bytes / 2 || internal_bitset::count(c.data, bitmap_bytes) != c.cardinality) fail(); break;
+					case kind::run: {
+						if(c.size == 0 || c.size % 2 != 0) fail();
+						std::uint32_t cardinality{0};
+						for(std::size_t j{0}; j < c.runs(); ++j) {
+							if(c.run_last(j) >= chunk_size) fail(); //would address values outside of the container
+							if(j != 0 && c.run_first(j) <= c.run_last(j - 1) + 1) fail(); //runs must neither overlap nor touch
+							cardinality += c.run_last(j) - c.run_first(j) + 1;
+						}
+						if(cardinality != c.cardinality) fail();
+					} break;
+				}
+			}
+		}
+
+		auto contains(std::uint32_t value) const noexcept -> bool { return internal_roaring_bitmap::algorithms::contains(*this, value); }
+
+		//! @returns number of contained values
+		auto cardinality() const noexcept -> std::uint64_t { return internal_roaring_bitmap::algorithms::cardinality(*this); }
+		[[nodiscard]]
+		auto empty() const noexcept -> bool { return count == 0; }
+	};
+
+	//! @brief a set of 32-bit values, compressed by storing each 64k chunk as a sorted array, a ptl::bitset<65536> or runs of consecutive values
+	//! @note binary stable layout: ptl::vector of containers {std::uint16_t key (upper 16 bits), std::uint8_t kind (0 = array, 1 = bitmap, 2 = run), std::uint32_t cardinality, ptl::vector<unsigned char> data} sorted by key
+	//! @note container data is stored in little endian order: arrays as sorted 16-bit values, bitmaps as the bytes of a ptl::bitset<65536>, runs as 16-bit pairs {first, last - first}
+	//! @note results of set operations are stored in their smallest representation, use optimize to apply this after modifying single values
+	class roaring_bitmap final {
+		friend internal_roaring_bitmap::algorithms;
+
+		vector<internal_roaring_bitmap::container> containers;
+
+		explicit
+		roaring_bitmap(vector<internal_roaring_bitmap::container> containers) noexcept : containers{std::move(containers)} {}
+
+		auto container_count() const noexcept -> std::size_t { return containers.size(); }
+		auto container_at(std::size_t index) const noexcept -> internal_roaring_bitmap::container_ref { return containers[index].ref(); }
+
+		//position of the container storing key, inserting an empty one if necessary
+		auto container_for(std::uint16_t key) -> internal_roaring_bitmap::container & {
+			const auto index{internal_roaring_bitmap::algorithms::find(*this, key)};
+			if(index == containers.size() || containers[index].key != key) containers.insert(containers.begin() + static_cast<std::ptrdiff_t>(index), internal_roaring_bitmap::container{key, internal_roaring_bitmap::kind::array, 0, {}});
+			return containers[index];
+		}
+	public:
+		//! @brief forward iterator over the contained values in ascending order
+		class const_iterator final {
+			friend roaring_bitmap;
+
+			const roaring_bitmap * self{nullptr};
+			std::size_t index{0};
+			std::uint32_t low{0};
+
+			const_iterator(const roaring_bitmap & self, std::size_t index) noexcept : self{&self}, index{index} { if(index < self.containers.size()) low = self.container_at(index).next(0); }
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = std::uint32_t;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = const std::uint32_t *;
+			using reference         = std::uint32_t;
+
+			const_iterator() noexcept =default;
+
+			auto operator++() noexcept -> const_iterator & { //TODO: [C++??] precondition(index < self->containers.size());
+				low = self->container_at(index).next(low + 1);
+				if(low == internal_roaring_bitmap::chunk_size) {
+					low = 0;
+					if(++index < self->containers.size()) low = self->container_at(index).next(0);
+				}
+				return *this;
+			}
+			auto operator++(int) noexcept -> const_iterator {
+				auto tmp{*this};
+				++*this;
+				return tmp;
+			}
+
+			auto operator*() const noexcept -> reference { return std::uint32_t{self->containers[index].key} << 16 | low; }
+
+			friend
+			auto operator==(const const_iterator & lhs, const const_iterator & rhs) noexcept -> bool { return lhs.index == rhs.index && lhs.low == rhs.low; }
+			friend
+			auto operator!=(const const_iterator & lhs, const const_iterator & rhs) noexcept -> bool { return !(lhs == rhs); } //TODO: [C++20] remove as implicitly generated
+		};
+		using iterator = const_iterator;
+
+		roaring_bitmap() noexcept =default;
+		roaring_bitmap(std::initializer_list<std::uint32_t> ilist) { for(const auto value : ilist) add(value); }
+		//! @brief decode a serialized bitmap
+		explicit
+		roaring_bitmap(const roaring_view & view) {
+			containers.reserve(view.container_count());
+			for(std::size_t i{0}; i < view.container_count(); ++i) containers.push_back(internal_roaring_bitmap::copy(view.container_at(i)));
+		}
+
+		//! @returns true if value was not contained before
+		auto add(std::uint32_t value) -> bool {
+			using namespace internal_roaring_bitmap;
+			auto & c{container_for(static_cast<std::uint16_t>(value >> 16))};
+			const auto low{static_cast<std::uint16_t>(value)};
+			const auto ref{c.ref()};
+			switch(c.type) {
+				case kind::array: {
+					const auto index{ref.lower_bound(low)};
+					if(index < ref.size && ref.value(index) == low) return false;
+					if(c.cardinality == max_array_cardinality) {
+						c.data = convert(ref, kind::bitmap, 0);
+						c.type = kind::bitmap;
+						return add(value);
+					}
+					unsigned char bytes[2];
+					store16(bytes, low);
+					c.data.insert(c.data.begin() + static_cast<std::ptrdiff_t>(index * 2), bytes, bytes + 2);
+				} break;
+				case kind::bitmap: {
+					auto & byte{c.data[low / 8]};
+					const auto mask{static_cast<unsigned char>(1 << (low % 8))};
+					if(byte & mask) return false;
+					byte |= mask;
+				} break;
+				case kind::run: {
+					const auto index{ref.upper_run(low)};
+					if(index != 0 && low <= ref.run_last(index - 1)) return false;
+					const auto extend_prev{index != 0 && ref.run_last(index - 1) + 1 == low}, extend_next{index < ref.runs() && low + 1u == ref.run_first(index)};
+					const auto ptr{c.data.data()};
+					if(extend_prev && extend_next) { //merge with the next run
+						store16(ptr + (index - 1) * 4 + 2, static_cast<std::uint16_t>(ref.run_last(index) - ref.run_first(index - 1)));
+						c.data.erase(c.data.begin() + static_cast<std::ptrdiff_t>(index * 4), c.data.begin() + static_cast<std::ptrdiff_t>(index * 4 + 4));
+					} else if(extend_prev) store16(ptr + (index - 1) * 4 + 2, static_cast<std::uint16_t>(low - ref.run_first(index - 1)));
+					else if(extend_next) {
+						store16(ptr + index * 4 + 2, static_cast<std::uint16_t>(ref.run_last(index) - low));
+						store16(ptr + index * 4, low);
+					} else {
+						unsigned char bytes[4];
+						store16(bytes, low);
+						store16(bytes + 2, 0);
+						c.data.insert(c.data.begin() + static_cast<std::ptrdiff_t>(index * 4), bytes, bytes + 4);
+					}
+					if(c.data.size() > bitmap_bytes) {
+						c.data = convert(c.ref(), kind::bitmap, 0);
+						c.type = kind::bitmap;
+					}
+				} break;
+			}
+			++c.cardinality;
+			return true;
+		}
+
+		//! @brief add all values in [first, last]
+		void add_range(std::uint32_t first, std::uint32_t last) { //TODO: [C++??] precondition(first <= last);
+			using namespace internal_roaring_bitmap;
+			for(auto key{first >> 16}; key <= last >> 16; ++key) {
+				const auto low{key == first >> 16 ? first & 0xFFFF : 0}, high{key == last >> 16 ? last & 0xFFFF : 0xFFFF};
+				unsigned char run[4];
+				store16(run, static_cast<std::uint16_t>(low));
+				store16(run + 2, static_cast<std::uint16_t>(high - low));
+				const container_ref range{static_cast<std::uint16_t>(key), kind::run, high - low + 1, run, 2};
+				auto & c{container_for(range.key)};
+				if(c.cardinality == 0) {
+					c = copy(range);
+					internal_roaring_bitmap::optimize(c);
+				} else c = unite(c.ref(), range);
+			}
+		}
+
+		//! @returns true if value was contained before
+		auto remove(std::uint32_t value) -> bool {
+			using namespace internal_roaring_bitmap;
+			const auto key{static_cast<std::uint16_t>(value >> 16)};
+			const auto position{algorithms::find(*this, key)};
+			if(position == containers.size() || containers[position].key != key) return false;
+			auto & c{containers[position]};
+			const auto low{static_cast<std::uint16_t>(value)};
+			const auto ref{c.ref()};
+			switch(c.type) {
+				case kind::array: {
+					const auto index{ref.lower_bound(low)};
+					if(index == ref.size || ref.value(index) != low) return false;
+					c.data.erase(c.data.begin() + static_cast<std::ptrdiff_t>(index * 2), c.data.begin() + static_cast<std::ptrdiff_t>(index * 2 + 2));
+				} break;
+				case kind::bitmap: {
+					auto & byte{c.data[low / 8]};
+					const auto mask{static_cast<unsigned char>(1 << (low % 8))};
+					if(!(byte & mask)) return false;
+					byte &= static_cast<unsigned char>(~mask);
+					if(c.cardinality - 1 <= max_array_cardinality) {
+						c.data = convert({c.key, c.type, c.cardinality - 1, c.data.data(), c.data.size() / 2}, kind::array, 0);
+						c.type = kind::array;
+					}
+				} break;
+				case kind::run: {
+					const auto index{ref.upper_run(low)};
+					if(index == 0 || low > ref.run_last(index - 1)) return false;
+					const auto first{ref.run_first(index - 1)}, last{ref.run_last(index - 1)};
+					const auto ptr{c.data.data() + (index - 1) * 4};
+					if(first == last) c.data.erase(c.data.begin() + static_cast<std::ptrdiff_t>((index - 1) * 4), c.data.begin() + static_cast<std::ptrdiff_t>(index * 4));
+					else if(low == first) {
+						store16(ptr, static_cast<std::uint16_t>(first + 1));
+						store16(ptr + 2, static_cast<std::uint16_t>(last - first - 1));
+					} else if(low == last) store16(ptr + 2, static_cast<std::uint16_t>(last - first - 1));
+					else { //split
+						store16(ptr + 2, static_cast<std::uint16_t>(low - 1 - first));
+						unsigned char bytes[4];
+						store16(bytes, static_cast<std::uint16_t>(low + 1));
+						store16(bytes + 2, static_cast<std::uint16_t>(last - low - 1));
+						c.data.insert(c.data.begin() + static_cast<std::ptrdiff_t>(index * 4), bytes, bytes + 4);
+						if(c.data.size() > bitmap_bytes) {
+							c.data = convert({c.key, c.type, c.cardinality - 1, c.data.data(), c.data.size() / 2}, kind::bitmap, 0);
+							c.type = kind::bitmap;
+						}
+					}
+				} break;
+			}
+			if(--c.cardinality == 0) containers.erase(containers.begin() + static_cast<std::ptrdiff_t>(position));
+			return true;
+		}
+
+		auto contains(std::uint32_t value) const noexcept -> bool { return internal_roaring_bitmap::algorithms::contains(*this, value); }
+
+		//! @returns number of contained values
+		auto cardinality() const noexcept -> std::uint64_t { return internal_roaring_bitmap::algorithms::cardinality(*this); }
+		[[nodiscard]]
+		auto empty() const noexcept -> bool { return containers.empty(); }
+
+		void clear() noexcept { containers.clear(); }
+
+		//! @brief store every container in its smallest representation
+		void optimize() { for(auto & c : containers) internal_roaring_bitmap::optimize(c); }
+
+		//! @returns number of bytes occupied by the containers
+		auto memory_usage() const noexcept -> std::size_t {
+			auto result{containers.capacity() * sizeof(internal_roaring_bitmap::container)};
+			for(const auto & c : containers) result += c.data.capacity();
+			return result;
+		}
+
+		auto begin() const noexcept -> const_iterator { return {*this, 0}; }
+		auto cbegin() const noexcept -> const_iterator { return begin(); }
+		auto end() const noexcept -> const_iterator { return {*this, containers.size()}; }
+		auto cend() const noexcept -> const_iterator { return end(); }
+
+		//! @returns number of bytes written by serialize
+		auto serialized_size() const noexcept -> std::size_t {
+			auto result{internal_roaring_bitmap::header_size + containers.size() * internal_roaring_bitmap::descriptor_size};
+			for(const auto & c : containers) result += c.data.size();
+			return result;
+		}
+		//! @brief write the portable representation that is accessible via roaring_view
+		//! @param[out] out destination of serialized_size() bytes
+		//! @returns end of the written data
+		auto serialize(unsigned char * out) const noexcept -> unsigned char * {
+			using namespace internal_roaring_bitmap;
+			std::memcpy(out, magic, sizeof(magic));
+			store32(out + 4, static_cast<std::uint32_t>(containers.size()));
+			auto offset{header_size + containers.size() * descriptor_size};
+			for(std::size_t i{0}; i < containers.size(); ++i) {
+				const auto & c{containers[i]};
+				const auto descriptor{out + header_size + i * descriptor_size};
+				store16(descriptor, c.key);
+				descriptor[2] = static_cast<unsigned char>(c.type);
+				descriptor[3] = 0;
+				store32(descriptor + 4, c.cardinality);
+				store32(descriptor + 8, static_cast<std::uint32_t>(c.data.size() / 2));
+				store32(descriptor + 12, static_cast<std::uint32_t>(offset));
+				if(!c.data.empty()) std::memcpy(out + offset, c.data.data(), c.data.size());
+				offset += c.data.size();
+			}
+			return out + offset;
+		}
+		auto serialize() const -> vector<unsigned char> {
+			vector<unsigned char> result;
+			result.resize_for_overwrite(serialized_size());
+			serialize(result.data());
+			return result;
+		}
+
+		auto operator&=(const roaring_bitmap & other) -> roaring_bitmap & { return *this = *this & other; }
+		auto operator|=(const roaring_bitmap & other) -> roaring_bitmap & { return *this = *this | other; }
+		auto operator-=(const roaring_bitmap & other) -> roaring_bitmap & { return *this = *this - other; }
+
+		void swap(roaring_bitmap & other) noexcept { containers.swap(other.containers); }
+		friend
+		void swap(roaring_bitmap & lhs, roaring_bitmap & rhs) noexcept { lhs.swap(rhs); }
+
+		friend
+		auto operator==(const roaring_bitmap & lhs, const roaring_bitmap & rhs) -> bool {
+			if(lhs.containers.size() != rhs.containers.size()) return false;
+			for(std::size_t i{0}; i < lhs.containers.size(); ++i)
+				if(!internal_roaring_bitmap::equal(lhs.container_at(i), rhs.container_at(i)))
+					return false;
+			return true;
+		}
+		friend
+		auto operator!=(const roaring_bitmap & lhs, const roaring_bitmap & rhs) -> bool { return !(lhs == rhs); } //TODO: [C++20] remove as implicitly generated
+
+		friend
+		auto operator&(const roaring_bitmap & lhs, const roaring_bitmap & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_intersection(lhs, rhs); }
+		friend
+		auto operator|(const roaring_bitmap & lhs, const roaring_bitmap & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_union(lhs, rhs); }
+		friend
+		auto operator-(const roaring_bitmap & lhs, const roaring_bitmap & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_difference(lhs, rhs); }
+	};
+
+	namespace internal_roaring_bitmap {
+		template<typename Lhs, typename Rhs>
+		auto algorithms::set_intersection(const Lhs & lhs, const Rhs & rhs) -> roaring_bitmap { return roaring_bitmap{combine(lhs, rhs, false, false, intersect)}; }
+		template<typename Lhs, typename Rhs>
+		auto algorithms::set_union(const Lhs & lhs, const Rhs & rhs) -> roaring_bitmap { return roaring_bitmap{combine(lhs, rhs, true, true, unite)}; }
+		template<typename Lhs, typename Rhs>
+		auto algorithms::set_difference(const Lhs & lhs, const Rhs & rhs) -> roaring_bitmap { return roaring_bitmap{combine(lhs, rhs, true, false, subtract)}; }
+	}
+
+	//set operations directly on serialized data
+	inline
+	auto operator&(const roaring_view & lhs, const roaring_view & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_intersection(lhs, rhs); }
+	inline
+	auto operator&(const roaring_view & lhs, const roaring_bitmap & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_intersection(lhs, rhs); }
+	inline
+	auto operator&(const roaring_bitmap & lhs, const roaring_view & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_intersection(lhs, rhs); }
+	inline
+	auto operator|(const roaring_view & lhs, const roaring_view & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_union(lhs, rhs); }
+	inline
+	auto operator|(const roaring_view & lhs, const roaring_bitmap & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_union(lhs, rhs); }
+	inline
+	auto operator|(const roaring_bitmap & lhs, const roaring_view & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_union(lhs, rhs); }
+	inline
+	auto operator-(const roaring_view & lhs, const roaring_view & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_difference(lhs, rhs); }
+	inline
+	auto operator-(const roaring_view & lhs, const roaring_bitmap & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_difference(lhs, rhs); }
+	inline
+	auto operator-(const roaring_bitmap & lhs, const roaring_view & rhs) -> roaring_bitmap { return internal_roaring_bitmap::algorithms::set_difference(lhs, rhs); }
+}
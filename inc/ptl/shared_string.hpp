@@ -0,0 +1,225 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <new>
+#include <tuple>
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <string_view>
+#include "hash.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+#include "string_ref.hpp"
+
+namespace ptl {
+	namespace internal_shared_string {
+		//binary stable header of every shared buffer, release is provided by the binary that created the buffer
+		struct owner {
+			std::atomic<std::size_t> refs;
+			void(*release)(owner * self) noexcept;
+		};
+		static_assert(std::atomic<std::size_t>::is_always_lock_free);
+		static_assert(sizeof(std::atomic<std::size_t>) == sizeof(std::size_t));
+
+		//characters are stored directly after the header
+		inline
+		auto allocate(std::string_view str) -> std::pair<owner *, const char *> {
+			const auto ptr{static_cast<unsigned char *>(::operator new(sizeof(owner) + str.size() + 1))};
+			const auto self{new(ptr) owner{{1}, +[](owner * self) noexcept {
+				self->~owner();
+				::operator delete(self);
+			}}};
+			const auto data{reinterpret_cast<char *>(ptr + sizeof(owner))};
+			std::memcpy(data, str.data(), str.size());
+			data[str.size()] = 0;
+			return {self, data};
+		}
+
+		//buffer taken over from a ptl::string, released with the deallocator of that string
+		struct adopted final : owner {
+			void(*dealloc)(char *) noexcept;
+			char * ptr;
+		};
+	}
+
+	//! @brief an immutable string whose content is shared between all copies
+	//! @note copies only increment an atomic reference count, making it suitable to fan out large payloads
+	//! @note binary stable layout: {owner *, const char * data, std::size_t size} with owner being {std::atomic<std::size_t> refs, void(*release)(owner *) noexcept}, both pointers are nullptr for an empty string
+	//! @note the last reference calls release, which was provided by the binary that created the content
+	class shared_string final {
+		internal_shared_string::owner * owner{nullptr};
+		const char * ptr{nullptr};
+		std::size_t siz{0};
+
+		void assign(std::string_view str) {
+			if(str.empty()) return;
+			std::tie(owner, ptr) = internal_shared_string::allocate(str);
+			siz = str.size();
+		}
+
+		void release() noexcept {
+			if(owner && owner->refs.fetch_sub(1, std::memory_order_release) == 1) {
+				std::atomic_thread_fence(std::memory_order_acquire);
+				owner->release(owner);
+			}
+		}
+	public:
+		using traits_type            = std::char_traits<char>;
+		using value_type             = char;
+		using size_type              = std::size_t;
+		using difference_type        = std::ptrdiff_t;
+		using reference              =       value_type &;
+		using const_reference        = const value_type &;
+		using pointer                =       value_type *;
+		using const_pointer          = const value_type *;
+		using iterator               = string_ref::iterator;
+		using const_iterator         = iterator;
+		using reverse_iterator       = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = reverse_iterator;
+
+		static
+		constexpr
+		size_type npos{string_ref::npos};
+
+		shared_string() noexcept =default;
+		shared_string(const shared_string & other) noexcept : owner{other.owner}, ptr{other.ptr}, siz{other.siz} { if(owner) owner->refs.fetch_add(1, std::memory_order_relaxed); }
+		shared_string(shared_string && other) noexcept : owner{std::exchange(other.owner, nullptr)}, ptr{std::exchange(other.ptr, nullptr)}, siz{std::exchange(other.siz, 0)} {}
+		auto operator=(const shared_string & other) noexcept -> shared_string & {
+			shared_string tmp{other};
+			swap(tmp);
+			return *this;
+		}
+		auto operator=(shared_string && other) noexcept -> shared_string & {
+			shared_string tmp{std::move(other)};
+			swap(tmp);
+			return *this;
+		}
+		~shared_string() noexcept { release(); }
+
+		//! @brief copy str into a newly allocated buffer (a single allocation)
+		explicit
+		shared_string(std::string_view str) { assign(str); }
+		//! @brief take over the memory of str without copying its characters
+		//! @note short strings stored inside str are copied instead
+		explicit
+		shared_string(string && str) {
+			if(!str.storage.on_heap()) assign(str);
+			else {
+				const auto self{new internal_shared_string::adopted{{{1}, +[](internal_shared_string::owner * self) noexcept {
+					const auto adopted{static_cast<internal_shared_string::adopted *>(self)};
+					adopted->dealloc(adopted->ptr);
+					delete adopted;
+				}}, nullptr, nullptr}};
+				const auto buffer{str.storage.release()};
+				self->dealloc = buffer.dealloc;
+				self->ptr = buffer.ptr;
+				owner = self;
+				ptr = buffer.ptr;
+				siz = buffer.siz;
+			}
+		}
+
+		auto operator[](size_type index) const noexcept -> const_reference { return ptr[index]; } //TODO: [C++??] precondition(index < size());
+		auto at(size_type index) const -> const_reference {
+			if(index >= size()) throw std::out_of_range{"ptl::shared_string::at - index out of range"};
+			return (*this)[index];
+		}
+
+		auto front() const noexcept -> const_reference { return (*this)[0]; } //TODO: [C++??] precondition(!empty());
+		auto back() const noexcept -> const_reference { return (*this)[size() - 1]; } //TODO: [C++??] precondition(!empty());
+
+		auto data() const noexcept -> const_pointer { return ptr ? ptr : ""; }
+		auto c_str() const noexcept -> const_pointer { return data(); }
+
+		[[nodiscard]]
+		auto empty() const noexcept -> bool { return size() == 0; }
+		auto size() const noexcept -> size_type { return siz; }
+
+		//! @returns number of shared_strings referencing the same content, 0 for an empty string
+		//! @note the value may change concurrently and is thus only a hint
+		auto use_count() const noexcept -> size_type { return owner ? owner->refs.load(std::memory_order_relaxed) : 0; }
+
+		auto begin() const noexcept -> iterator { return static_cast<string_ref>(*this).begin(); }
+		auto cbegin() const noexcept -> const_iterator { return begin(); }
+		auto end() const noexcept -> iterator { return static_cast<string_ref>(*this).end(); }
+		auto cend() const noexcept -> const_iterator { return end(); }
+		auto rbegin() const noexcept -> reverse_iterator { return reverse_iterator{end()}; }
+		auto crbegin() const noexcept -> const_reverse_iterator { return rbegin(); }
+		auto rend() const noexcept -> reverse_iterator { return reverse_iterator{begin()}; }
+		auto crend() const noexcept -> const_reverse_iterator { return rend(); }
+
+		void swap(shared_string & other) noexcept {
+			std::swap(owner, other.owner);
+			std::swap(ptr, other.ptr);
+			std::swap(siz, other.siz);
+		}
+		friend
+		void swap(shared_string & lhs, shared_string & rhs) noexcept { lhs.swap(rhs); }
+
+		//TODO: [C++20] replace the ordering operators by <=>
+		friend
+		auto operator< (const shared_string & lhs, const shared_string & rhs) noexcept -> bool { return lhs <  static_cast<std::string_view>(rhs); }
+		friend
+		auto operator<=(const shared_string & lhs, const shared_string & rhs) noexcept -> bool { return lhs <= static_cast<std::string_view>(rhs); }
+		friend
+		auto operator>=(const shared_string & lhs, const shared_string & rhs) noexcept -> bool { return lhs >= static_cast<std::string_view>(rhs); }
+		friend
+		auto operator> (const shared_string & lhs, const shared_string & rhs) noexcept -> bool { return lhs >  static_cast<std::string_view>(rhs); }
+		friend
+		auto operator==(const shared_string & lhs, const shared_string & rhs) noexcept -> bool { return lhs.ptr == rhs.ptr ? lhs.siz == rhs.siz : lhs == static_cast<std::string_view>(rhs); }
+		friend
+		auto operator!=(const shared_string & lhs, const shared_string & rhs) noexcept -> bool { return !(lhs == rhs); } //TODO: [C++20] remove as implicitly generated
+		//TODO: [C++20] replace the ordering operators by <=>
+		friend
+		auto operator< (std::string_view lhs, const shared_string & rhs) noexcept -> bool { return lhs <  static_cast<std::string_view>(rhs); }
+		friend
+		auto operator<=(std::string_view lhs, const shared_string & rhs) noexcept -> bool { return lhs <= static_cast<std::string_view>(rhs); }
+		friend
+		auto operator>=(std::string_view lhs, const shared_string & rhs) noexcept -> bool { return lhs >= static_cast<std::string_view>(rhs); }
+		friend
+		auto operator> (std::string_view lhs, const shared_string & rhs) noexcept -> bool { return lhs >  static_cast<std::string_view>(rhs); }
+		friend
+		auto operator==(std::string_view lhs, const shared_string & rhs) noexcept -> bool { return lhs == static_cast<std::string_view>(rhs); }
+		friend
+		auto operator!=(std::string_view lhs, const shared_string & rhs) noexcept -> bool { return lhs != static_cast<std::string_view>(rhs); } //TODO: [C++20] remove as implicitly generated
+		//TODO: [C++20] replace the ordering operators by <=>
+		friend
+		auto operator< (const shared_string & lhs, std::string_view rhs) noexcept -> bool { return static_cast<std::string_view>(lhs) <  rhs; }
+		friend
+		auto operator<=(const shared_string & lhs, std::string_view rhs) noexcept -> bool { return static_cast<std::string_view>(lhs) <= rhs; }
+		friend
+		auto operator>=(const shared_string & lhs, std::string_view rhs) noexcept -> bool { return static_cast<std::string_view>(lhs) >= rhs; }
+		friend
+		auto operator> (const shared_string & lhs, std::string_view rhs) noexcept -> bool { return static_cast<std::string_view>(lhs) >  rhs; }
+		friend
+		auto operator==(const shared_string & lhs, std::string_view rhs) noexcept -> bool { return static_cast<std::string_view>(lhs) == rhs; }
+		friend
+		auto operator!=(const shared_string & lhs, std::string_view rhs) noexcept -> bool { return static_cast<std::string_view>(lhs) != rhs; } //TODO: [C++20] remove as implicitly generated
+
+		friend
+		auto operator<<(std::ostream & os, const shared_string & self) -> std::ostream & { return os << static_cast<std::string_view>(self); }
+
+		//! @brief convert to ptl::string_ref
+		operator string_ref() const noexcept { return {data(), siz}; }
+		//! @brief convert to std::string_view
+		operator std::string_view() const noexcept { return {data(), siz}; }
+	};
+	static_assert(sizeof(shared_string) == 3 * sizeof(void *));
+
+	template<>
+	struct is_trivially_relocatable<shared_string> : std::true_type {};
+}
+
+namespace std {
+	template<>
+	struct hash<ptl::shared_string> {
+		auto operator()(const ptl::shared_string & self) const noexcept -> std::size_t { return static_cast<std::size_t>(ptl::hash_bytes(self.data(), self.size())); }
+	};
+}
@@ -7,15 +7,28 @@
 #pragma once
 #include <limits>
 #include <memory>
+#include <cstdint>
 #include <cstring>
+#include <utility>
+#include <charconv>
 #include <iterator>
+#include <functional>
 #include <algorithm>
 #include <stdexcept>
 #include <string_view>
+#include "hash.hpp"
+#include "array_ref.hpp"
+#include "string_ref.hpp"
+#include "allocation_policy.hpp"
+#include "internal/utils.hpp"
 
 namespace ptl {
+	class shared_string;
+
 	//! @brief a dynamically growing string
 	class string final { //TODO: [C++20] constexpr
+		friend shared_string;
+
 		class storage_t final {
 			static
 			constexpr
@@ -34,66 +47,73 @@ namespace ptl {
 				} heap;
 			};
 
+			//every byte of the union is always initialized, so the accessors may read both representations and select one without branching
 			void clear_to_sso() noexcept {
 				dealloc = nullptr;
-				sso.siz = 0;
-				sso.buf[0] = 0;
+				std::memset(&sso, 0, sizeof(sso));
 			}
 
-			void copy_sso(const storage_t & other) noexcept {
-				sso.siz = other.sso.siz;
-				std::memcpy(sso.buf, other.sso.buf, sso.siz + 1);
+			void move_from(storage_t & other) noexcept {
+				dealloc = other.dealloc;
+				std::memcpy(&sso, &other.sso, sizeof(sso));
+				if(dealloc) other.clear_to_sso(); //short strings are copied
 			}
 
-			void move_heap(storage_t & other) noexcept {
-				heap = other.heap;
-				other.clear_to_sso();
-			}
+			//all bits set if the string is stored on the heap, none otherwise
+			auto heap_mask() const noexcept -> std::uintptr_t { return std::uintptr_t{0} - static_cast<std::uintptr_t>(dealloc != nullptr); }
 		public:
 			storage_t() noexcept { clear_to_sso(); }
 
-			storage_t(std::size_t required) {
-				if(required > sso_size) {
-					dealloc = +[](char * ptr) noexcept { delete[] ptr; }; 
-					heap.siz = 0;
+			storage_t(std::size_t required, allocation_policy * policy = nullptr) {
+				if(required > sso_size || policy) { //memory from a policy is always used to keep the policy for further growth
 					//minimum heap allocation: 2xSSO to prevent multiple allocations on push_back/etc. after initially exceeding SSO
-					heap.cap = std::max(std::size_t{2}, (required + sizeof(sso) - 1) / sizeof(sso)) * sizeof(sso);
-					heap.ptr = new char[heap.cap + 1];
+					const auto cap{std::max(std::size_t{2}, (required + sizeof(sso) - 1) / sizeof(sso)) * sizeof(sso)};
+					if(policy) {
+						heap.ptr = static_cast<char *>(internal_allocation_policy::allocate(*policy, cap + 1));
+						dealloc = &internal_allocation_policy::deallocate<char>;
+					} else {
+						heap.ptr = new char[cap + 1];
+						dealloc = +[](char * ptr) noexcept { delete[] ptr; };
+					}
+					heap.cap = cap;
+					heap.siz = 0;
 					heap.ptr[0] = 0;
 				} else clear_to_sso();
 			}
 
-			storage_t(storage_t && other) noexcept : dealloc{other.dealloc} {
-				if(dealloc) move_heap(other);
-				else copy_sso(other);
-			}
+			storage_t(storage_t && other) noexcept { move_from(other); }
 			auto operator=(storage_t && other) noexcept -> storage_t & {
 				if(this != std::addressof(other)) { //TODO: [C++20] use [[likely]]
 					if(dealloc) dealloc(heap.ptr);
-					dealloc = other.dealloc;
-					if(dealloc) move_heap(other);
-					else copy_sso(other);
+					move_from(other);
 				}
 				return *this;
 			}
 
 			~storage_t() noexcept { if(dealloc) dealloc(heap.ptr); }
 
-			auto data() const noexcept -> const char * { return dealloc ? heap.ptr : sso.buf; }
-			auto data()       noexcept ->       char * { return dealloc ? heap.ptr : sso.buf; }
+			auto data() const noexcept -> const char * {
+				const auto mask{heap_mask()};
+				return reinterpret_cast<const char *>((reinterpret_cast<std::uintptr_t>(heap.ptr) & mask) | (reinterpret_cast<std::uintptr_t>(sso.buf) & ~mask));
+			}
+			auto data()       noexcept ->       char * { return const_cast<char *>(std::as_const(*this).data()); }
+
+			auto capacity() const noexcept -> std::size_t {
+				const auto mask{heap_mask()};
+				return static_cast<std::size_t>((heap.cap & mask) | (sso_size & ~mask));
+			}
 
-			auto capacity() const noexcept -> std::size_t { return dealloc ? heap.cap : sso_size; }
+			auto policy() const noexcept -> allocation_policy * { return dealloc ? internal_allocation_policy::policy_of(dealloc, heap.ptr) : nullptr; }
 
 			void set_size(std::size_t val) noexcept { //TODO: [C++??] precondition(val <= capacity());
-				if(dealloc) {
-					heap.siz = val;
-					heap.ptr[val] = 0;
-				} else {
-					sso.siz = static_cast<char>(val);
-					sso.buf[val] = 0;
-				}
+				if(dealloc) heap.siz = val;
+				else sso.siz = static_cast<char>(val);
+				data()[val] = 0;
+			}
+			auto size() const noexcept -> std::size_t {
+				const auto mask{heap_mask()};
+				return static_cast<std::size_t>((heap.siz & mask) | (static_cast<unsigned char>(sso.siz) & ~mask));
 			}
-			auto size() const noexcept -> std::size_t { return dealloc ? heap.siz : sso.siz; }
 
 			void shrink_to_fit() noexcept { //only shrink from heap to sso
 				if(!dealloc) return;
@@ -108,32 +128,24 @@ namespace ptl {
 				dealloc = nullptr;
 			}
 
-			void swap(storage_t & other) noexcept {
-				if(this == std::addressof(other)) return; //TODO: [C++20] use [[unlikely]] on condition
-				else if(dealloc && other.dealloc) {
-					std::swap(heap.ptr, other.heap.ptr);
-					std::swap(heap.cap, other.heap.cap);
-					std::swap(heap.siz, other.heap.siz);
-					std::swap(dealloc, other.dealloc);
-				} else if(!dealloc && !other.dealloc) {
-					char tmp[sso_size + 1];
-					std::copy_n(sso.buf, sso.siz + 1, tmp);
-					std::copy_n(other.sso.buf, other.sso.siz + 1, sso.buf);
-					std::copy_n(tmp, sso.siz + 1, other.sso.buf);
-					std::swap(sso.siz, other.sso.siz);
-				} else {
-					auto & on_heap{dealloc ? *this : other};
-					auto & on_sso{dealloc ? other : *this};
-
-					const auto tmp{on_heap.heap};
+			struct buffer final {
+				void(*dealloc)(char *) noexcept;
+				char * ptr;
+				std::size_t siz;
+			};
 
-					on_heap.sso.siz = on_sso.sso.siz;
-					std::copy_n(on_sso.sso.buf, on_sso.sso.siz + 1, on_heap.sso.buf);
+			auto on_heap() const noexcept -> bool { return dealloc; }
 
-					on_sso.heap = tmp;
+			//transfers ownership of the heap memory to the caller, who has to release it with dealloc
+			auto release() noexcept -> buffer { //TODO: [C++??] precondition(on_heap());
+				const buffer result{dealloc, heap.ptr, heap.siz};
+				clear_to_sso();
+				return result;
+			}
 
-					std::swap(dealloc, other.dealloc);
-				}
+			void swap(storage_t & other) noexcept { //neither representation references the object itself => swapping the bytes is sufficient
+				std::swap(dealloc, other.dealloc);
+				std::swap(sso, other.sso);
 			}
 		} storage;
 
@@ -234,14 +246,159 @@ namespace ptl {
 			pointer ptr{nullptr};
 		};
 
+		//lazy result of operator+, measures the total size first and allocates once when converted to string
+		//NOTE: nested in string => string's operators are found via ADL
+		template<typename Lhs, typename Rhs>
+		class concatenation final {
+			template<typename, typename>
+			friend class concatenation;
+			friend string;
+
+			Lhs lhs;
+			Rhs rhs;
+
+			static
+			auto size_of(char) noexcept -> std::size_t { return 1; }
+			static
+			auto size_of(std::string_view str) noexcept -> std::size_t { return str.size(); }
+			template<typename L, typename R>
+			static
+			auto size_of(const concatenation<L, R> & expr) noexcept -> std::size_t { return expr.size(); }
+
+			static
+			auto write(char * ptr, char ch) noexcept -> char * {
+				*ptr = ch;
+				return ptr + 1;
+			}
+			static
+			auto write(char * ptr, std::string_view str) noexcept -> char * { return std::copy_n(str.data(), str.size(), ptr); }
+			template<typename L, typename R>
+			static
+			auto write(char * ptr, const concatenation<L, R> & expr) noexcept -> char * { return expr.write(ptr); }
+
+			auto write(char * ptr) const noexcept -> char * { return write(write(ptr, lhs), rhs); }
+		public:
+			template<typename L, typename R>
+			concatenation(L && lhs, R && rhs) : lhs(std::forward<L>(lhs)), rhs(std::forward<R>(rhs)) {}
+
+			//! @brief size of the resulting string
+			auto size() const noexcept -> std::size_t { return size_of(lhs) + size_of(rhs); }
+
+			//! @brief materialize the expression with a single allocation
+			operator string() const {
+				const auto count{size()};
+				string result;
+				result.storage = count;
+				write(result.data());
+				result.storage.set_size(count);
+				return result;
+			}
+		};
+
+		template<typename Type>
+		struct is_concatenation : std::false_type {};
+		template<typename Lhs, typename Rhs>
+		struct is_concatenation<concatenation<Lhs, Rhs>> : std::true_type {};
+
+		template<typename Type>
 		static
-		auto concat(std::string_view lhs, std::string_view rhs) -> string {
-			const auto count{lhs.size() + rhs.size()};
-			string tmp;
-			tmp.storage = count;
-			tmp.storage.set_size(count);
-			std::copy_n(rhs.data(), rhs.size(), std::copy_n(lhs.data(), lhs.size(), tmp.data()));
-			return tmp;
+		constexpr
+		bool is_operand_v{std::is_same_v<std::decay_t<Type>, char> || is_concatenation<std::decay_t<Type>>::value || std::is_convertible_v<Type, std::string_view>};
+
+		template<typename Type>
+		static
+		constexpr
+		bool is_expression_v{std::is_same_v<std::decay_t<Type>, string> || is_concatenation<std::decay_t<Type>>::value};
+
+		//lvalues and pointers are referenced, other rvalues (e.g. temporary strings) are moved into the expression to keep it valid beyond the full-expression
+		template<typename Type, typename Decayed = std::decay_t<Type>>
+		using operand_t = std::conditional_t<std::is_same_v<Decayed, char> || is_concatenation<Decayed>::value || (!std::is_lvalue_reference_v<Type> && !std::is_pointer_v<Decayed> && !std::is_same_v<Decayed, std::string_view>), Decayed, std::string_view>;
+
+		auto ref() const noexcept -> string_ref { return {data(), size()}; }
+
+		//longest shortest-round-trip representation of a double, e.g. "-2.2250738585072014e-308"
+		static
+		constexpr
+		std::size_t max_float_chars{24};
+
+		auto grow_capacity(std::size_t required) const -> std::size_t {
+			if(required > max_size()) throw std::length_error{"ptl::string - exceeding max_size"};
+			return internal_utils::grow_capacity(capacity(), required, max_size());
+		}
+
+		//iterators whose characters are stored contiguously, thus may be copied with memmove
+		template<typename Iterator>
+		static
+		constexpr
+		bool is_contiguous_v{std::is_same_v<Iterator, const char *> || std::is_same_v<Iterator, char *> || std::is_same_v<Iterator, contiguous_iterator<true>> || std::is_same_v<Iterator, contiguous_iterator<false>> || std::is_same_v<Iterator, string_ref::iterator>};
+
+		template<typename Iterator>
+		static
+		auto address_of(Iterator it) noexcept -> const char * {
+			if constexpr(std::is_pointer_v<Iterator>) return it;
+			else return it.operator->(); //never dereferences, thus valid for end iterators
+		}
+
+		//replace [offset, offset + count) with [src, src + size), moving every character at most once
+		//src may point into this string, the remainder of the string is moved before or after copying src depending on the direction of the move
+		void replace_chars(std::size_t offset, std::size_t count, const char * src, std::size_t size) { //TODO: [C++??] precondition(offset + count <= this->size());
+			const auto old{this->size()}, tail{old - offset - count}, required{old - count + size};
+			if(required > capacity()) { //single allocation, src is still intact while copying
+				storage_t tmp{grow_capacity(required), storage.policy()};
+				traits_type::copy(tmp.data(), data(), offset);
+				traits_type::copy(tmp.data() + offset, src, size);
+				traits_type::copy(tmp.data() + offset + size, data() + offset + count, tail);
+				tmp.set_size(required);
+				storage = std::move(tmp);
+				return;
+			}
+			const auto ptr{data()};
+			if(size <= count) { //tail moves to the front => copy src before it can be overwritten
+				traits_type::move(ptr + offset, src, size);
+				traits_type::move(ptr + offset + size, ptr + offset + count, tail);
+			} else { //tail moves to the back => characters of src behind the replaced range move along
+				const auto gap{ptr + offset + count};
+				traits_type::move(ptr + offset + size, gap, tail);
+				const std::less<const char *> less;
+				const auto unmoved{less(src, ptr) || !less(src, ptr + old) ? size : less(src, gap) ? std::min(size, static_cast<std::size_t>(gap - src)) : 0}; //prefix of src that is located in front of the gap
+				traits_type::move(ptr + offset, src, unmoved);
+				traits_type::move(ptr + offset + unmoved, src + unmoved + (size - count), size - unmoved);
+			}
+			storage.set_size(required);
+		}
+
+		//as replace_chars for arbitrary forward iterators, which may reference this string as well
+		template<typename ForwardIterator>
+		void replace_range(std::size_t offset, std::size_t count, ForwardIterator first, ForwardIterator last) { //TODO: [C++??] precondition(offset + count <= size());
+			const auto size{static_cast<std::size_t>(std::distance(first, last))};
+			if constexpr(is_contiguous_v<ForwardIterator>) replace_chars(offset, count, address_of(first), size);
+			else {
+				const auto old{this->size()}, required{old - count + size}, staging{std::max(old, required)};
+				if(size <= capacity() && staging <= capacity() - size) { //stage behind the old and the new content, where the source can't reside
+					std::copy(first, last, data() + staging);
+					replace_chars(offset, count, data() + staging, size);
+				} else {
+					storage_t tmp{grow_capacity(required), storage.policy()};
+					std::copy(first, last, tmp.data() + offset);
+					traits_type::copy(tmp.data(), data(), offset);
+					traits_type::copy(tmp.data() + offset + size, data() + offset + count, old - offset - count);
+					tmp.set_size(required);
+					storage = std::move(tmp);
+				}
+			}
+		}
+
+		//convert directly into the spare capacity, growing until convert succeeds
+		template<typename Convert>
+		void append_chars(std::size_t estimate, Convert convert) {
+			for(;;) {
+				if(capacity() - size() < estimate) reserve(grow_capacity(size() + estimate));
+				if(const auto [ptr, ec]{convert(data() + size(), data() + capacity())}; ec == std::errc{}) {
+					storage.set_size(static_cast<std::size_t>(ptr - data()));
+					return;
+				}
+				estimate = (capacity() - size()) * 2; //only happens for large precisions
+			}
 		}
 
 		template<typename Func>
@@ -294,6 +451,10 @@ namespace ptl {
 		using reverse_iterator       = std::reverse_iterator<      iterator>;
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+		static
+		constexpr
+		size_type npos{string_ref::npos};
+
 		string() noexcept =default;
 
 		string(const string & other) : string{static_cast<std::string_view>(other)} {}
@@ -323,6 +484,14 @@ namespace ptl {
 		}
 		string(std::initializer_list<char> ilist) : string{ilist.begin(), ilist.end()} {}
 
+		//! @brief create an empty string whose memory is provided by a custom policy
+		//! @param[in] policy source of all future allocations of this string (copies use the global heap)
+		//! @param[in] capacity initial capacity, allocated immediately
+		//! @note the policy is found via the allocated memory, thus objects can be destroyed by binaries built with other compilers
+		//! @attention shrink_to_fit may move the content back into the object, releasing the policy
+		explicit
+		string(allocation_policy & policy, size_type capacity = 0) : storage{capacity, &policy} {}
+
 		auto operator=(std::string_view str) -> string & {
 			assign(str);
 			return *this;
@@ -336,10 +505,6 @@ namespace ptl {
 			append(str);
 			return *this;
 		}
-		friend
-		auto operator+(std::string_view lhs, const string & rhs) -> string { return concat(lhs, rhs); }
-		friend
-		auto operator+(const string & lhs, std::string_view rhs) -> string { return concat(lhs, rhs); }
 		auto operator+=(std::initializer_list<char> ilist) -> string & {
 			append(ilist);
 			return *this;
@@ -348,17 +513,31 @@ namespace ptl {
 			append(1, ch);
 			return *this;
 		}
-		friend
-		auto operator+(char lhs, const string & rhs) -> string { return concat({&lhs, 1}, rhs); }
-		friend
-		auto operator+(const string & lhs, char rhs) -> string { return concat(lhs, {&rhs, 1}); }
 
 		auto operator+=(const string & other) -> string & {
 			append(other);
 			return *this;
 		}
+
+		template<typename Lhs, typename Rhs>
+		auto operator+=(const concatenation<Lhs, Rhs> & expr) -> string & {
+			const auto old{size()}, count{expr.size()};
+			if(old + count <= capacity()) expr.write(data() + old); //expr may only reference [0, old) of this string
+			else {
+				storage_t tmp{grow_capacity(old + count), storage.policy()};
+				expr.write(std::copy_n(data(), old, tmp.data()));
+				storage = std::move(tmp);
+			}
+			storage.set_size(old + count);
+			return *this;
+		}
+
+		//! @brief concatenate strings, string views and characters
+		//! @returns expression that is materialized with a single allocation when converted to string (or appended to one)
+		//! @attention lvalue operands are referenced (rvalues are moved into the expression), thus the expression must not outlive them
+		template<typename Lhs, typename Rhs, std::enable_if_t<(is_expression_v<Lhs> || is_expression_v<Rhs>) && is_operand_v<Lhs> && is_operand_v<Rhs>, int> = 0> //TODO: [C++20] replace with concepts/requires-clause
 		friend
-		auto operator+(const string & lhs, const string & rhs) -> string { return concat(lhs, rhs); }
+		auto operator+(Lhs && lhs, Rhs && rhs) -> concatenation<operand_t<Lhs>, operand_t<Rhs>> { return {std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)}; }
  
 		auto operator[](size_type index) const noexcept -> const_reference { return data()[index]; } //TODO: [C++??] precondition(index < size());
 		auto operator[](size_type index)       noexcept ->       reference { return data()[index]; } //TODO: [C++??] precondition(index < size());
@@ -386,18 +565,21 @@ namespace ptl {
 		static
 		auto max_size() noexcept-> size_type { return static_cast<size_type>(std::numeric_limits<difference_type>::max()) - 1; }
 		auto capacity() const noexcept -> size_type { return storage.capacity(); }
+		//! @returns policy providing the current memory, nullptr for the global heap or the internal buffer
+		//! @note memory provided by a policy through another binary is not detected and reported as nullptr
+		auto policy() const noexcept -> allocation_policy * { return storage.policy(); }
 
 		auto push_back(char ch) -> reference {
-			if(size() == capacity()) reserve(size() + 1);
-			resize(size() + 1, ch);
-			return back();
+			if(size() == capacity()) reserve(grow_capacity(size() + 1));
+			storage.set_size(size() + 1);
+			return back() = ch;
 		}
 		void pop_back() noexcept { storage.set_size(size() - 1); } //TODO: [C++??] precondition(!empty());
 
 		void reserve(size_type new_capacity) {
 			if(new_capacity <= capacity()) return;
 			if(new_capacity > max_size()) throw std::length_error{"ptl::string::reserve - exceeding max_size"};
-			storage_t tmp{new_capacity};
+			storage_t tmp{new_capacity, storage.policy()};
 			tmp.set_size(size());
 			if(!empty()) std::copy_n(data(), size() + 1, tmp.data());
 			storage = std::move(tmp);
@@ -406,7 +588,7 @@ namespace ptl {
 		void resize(size_type count) { resize(count, 0); }
 		void resize(size_type count, char ch) {
 			const auto old{size()};
-			reserve(count);
+			if(count > capacity()) reserve(grow_capacity(count));
 			storage.set_size(count);
 			if(old < size()) std::fill(data() + old, data() + size(), ch);
 		}
@@ -430,7 +612,7 @@ namespace ptl {
 				std::copy(first, last, data() + size());
 				storage.set_size(size() + distance);
 			} else { //do single allocation
-				storage_t tmp{size() + distance};
+				storage_t tmp{grow_capacity(size() + distance), storage.policy()};
 				std::copy(first, last, tmp.data() + size());
 				std::move(data(), data() + size(), tmp.data());
 				tmp.set_size(size() + distance);
@@ -441,19 +623,50 @@ namespace ptl {
 		void append(std::initializer_list<char> ilist) { append_no_aliasing(ilist.size(), [&](auto offset) { std::copy(ilist.begin(), ilist.end(), data() + offset); }); }
 		void append(size_type count, char ch) { append_no_aliasing(count, [&](auto offset) { std::fill_n(data() + offset, count, ch); }); }
 
+		//! @brief append the textual representation of value in base using std::to_chars
+		//! @note locale independent and formatted directly into the spare capacity without temporary strings
+		template<typename Integer, std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>, int> = 0> //TODO: [C++20] replace with concepts/requires-clause
+		void append_integer(Integer value, int base = 10) { //TODO: [C++??] precondition(2 <= base && base <= 36);
+			const auto estimate{static_cast<std::size_t>(base == 10 ? std::numeric_limits<Integer>::digits10 + 2 : std::numeric_limits<Integer>::digits + 1)}; //sign and all digits
+			append_chars(estimate, [&](char * first, char * last) { return std::to_chars(first, last, value, base); });
+		}
+		//! @brief append the shortest textual representation of value that parses back to value using std::to_chars
+		//! @note locale independent and formatted directly into the spare capacity without temporary strings
+		template<typename Float, std::enable_if_t<std::is_floating_point_v<Float>, int> = 0> //TODO: [C++20] replace with concepts/requires-clause
+		void append_float(Float value) { append_chars(max_float_chars, [&](char * first, char * last) { return std::to_chars(first, last, value); }); }
+		template<typename Float, std::enable_if_t<std::is_floating_point_v<Float>, int> = 0> //TODO: [C++20] replace with concepts/requires-clause
+		void append_float(Float value, std::chars_format fmt) { append_chars(max_float_chars, [&](char * first, char * last) { return std::to_chars(first, last, value, fmt); }); }
+		template<typename Float, std::enable_if_t<std::is_floating_point_v<Float>, int> = 0> //TODO: [C++20] replace with concepts/requires-clause
+		void append_float(Float value, std::chars_format fmt, int precision) { append_chars(max_float_chars + static_cast<std::size_t>(std::max(precision, 0)), [&](char * first, char * last) { return std::to_chars(first, last, value, fmt, precision); }); }
+
+		//! @brief append the shortest textual representation of all values, separated by separator
+		//! @note capacity is checked once for the whole batch, which may overallocate by up to max_float_chars characters per value
+		void append_floats(array_ref<const double> values, std::string_view separator = ",") {
+			if(values.empty()) return;
+			const auto per_value{max_float_chars + separator.size()};
+			if(values.size() > (max_size() - size()) / per_value) throw std::length_error{"ptl::string - exceeding max_size"};
+			reserve(size() + values.size() * per_value);
+			auto ptr{std::to_chars(data() + size(), data() + capacity(), values[0]).ptr};
+			for(std::size_t i{1}; i < values.size(); ++i) {
+				ptr = std::copy_n(separator.data(), separator.size(), ptr);
+				ptr = std::to_chars(ptr, ptr + max_float_chars, values[i]).ptr;
+			}
+			storage.set_size(static_cast<std::size_t>(ptr - data()));
+		}
+
 		template<typename InputIterator, std::enable_if_t<std::is_same_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>, int> = 0> //TODO: [C++20] replace with concepts/requires-clause
 		void assign(InputIterator first, InputIterator last) { *this = string(first, last); }
 		template<typename ForwardIterator, std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<ForwardIterator>::iterator_category>, int> = 0> //TODO: [C++20] replace with concepts/requires-clause
 		void assign(ForwardIterator first, ForwardIterator last) {
-			if(const auto distance{static_cast<std::size_t>(std::distance(first, last))}; distance + size() <= capacity()) { //no need for allocation nor double buffering
-				std::copy(first, last, data() + size());
-				std::rotate(data(), data() + size(), data() + size() + distance);
-				storage.set_size(distance);
-			} else {
-				*this = string(first, last); //TODO: this is probably sub-optimal as it falls back to InputIterator-logic
+			if(const auto distance{static_cast<std::size_t>(std::distance(first, last))}; distance <= capacity()) replace_range(0, size(), first, last);
+			else { //the old content is not needed => allocate exactly
+				storage_t tmp{distance, storage.policy()};
+				tmp.set_size(distance);
+				std::copy(first, last, tmp.data());
+				storage = std::move(tmp);
 			}
 		}
-		void assign(std::string_view str) { assign(str.begin(), str.end()); }
+		void assign(std::string_view str) { assign(str.data(), str.data() + str.size()); }
 		void assign(std::initializer_list<char> ilist) { assign_no_aliasing(ilist.size(), [&] { std::copy(ilist.begin(), ilist.end(), data()); }); }
 		void assign(size_type count, char ch) { assign_no_aliasing(count, [&] { std::fill_n(data(), count, ch); }); }
 
@@ -471,23 +684,11 @@ namespace ptl {
 		}
 		template<typename ForwardIterator, std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<ForwardIterator>::iterator_category>, int> = 0> //TODO: [C++20] replace with concepts/requires-clause
 		auto insert(const_iterator pos, ForwardIterator first, ForwardIterator last) -> iterator { //TODO: [C++??] precondition(begin() <= pos && pos <= end());
-			const auto distance{static_cast<std::size_t>(std::distance(first, last))};
-			const auto offset{pos.ptr - data()};
-			if(distance + size() <= capacity()) { //no need for allocation nor double buffering
-				std::copy(first, last, data() + size());
-				std::rotate(const_cast<char *>(pos.ptr), data() + size(), data() + size() + distance);
-				storage.set_size(size() + distance);
-			} else { //do single allocation
-				storage_t tmp{size() + distance};
-				std::copy(first, last, tmp.data() + offset);
-				std::move(data(), data() + offset, tmp.data());
-				std::move(data() + offset, data() + size(), tmp.data() + offset + distance);
-				tmp.set_size(size() + distance);
-				storage = std::move(tmp);
-			}
+			const auto offset{static_cast<std::size_t>(pos.ptr - data())};
+			replace_range(offset, 0, first, last);
 			return begin() + offset;
 		}
-		auto insert(const_iterator pos, std::string_view str) -> iterator { return insert(pos, str.begin(), str.end()); } //TODO: [C++??] precondition(begin() <= pos && pos <= end());
+		auto insert(const_iterator pos, std::string_view str) -> iterator { return insert(pos, str.data(), str.data() + str.size()); } //TODO: [C++??] precondition(begin() <= pos && pos <= end());
 		auto insert(const_iterator pos, std::initializer_list<char> ilist) -> iterator { return insert_no_aliasing(pos, ilist.size(), [&, offset{pos.ptr - data()}] { std::copy(ilist.begin(), ilist.end(), data() + offset); }); } //TODO: [C++??] precondition(begin() <= pos && pos <= end());
 		auto insert(const_iterator pos, char ch) -> iterator { return insert(pos, 1, ch); } //TODO: [C++??] precondition(begin() <= pos && pos <= end());
 		auto insert(const_iterator pos, size_type count, char ch) -> iterator { return insert_no_aliasing(pos, count, [&, offset{pos.ptr - data()}] { std::fill_n(data() + offset, count, ch); }); } //TODO: [C++??] precondition(begin() <= pos && pos <= end());
@@ -500,25 +701,10 @@ namespace ptl {
 		}
 		template<typename ForwardIterator, std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<ForwardIterator>::iterator_category>, int> = 0> //TODO: [C++20] replace with concepts/requires-clause
 		auto replace(const_iterator first, const_iterator last, ForwardIterator first2, ForwardIterator last2) -> string & { //TODO: [C++??] precondition(begin() <= first && first <= last && last <= end());
-			const auto distance{static_cast<std::size_t>(std::distance(first2, last2))};
-			if(distance + size() <= capacity()) { //no need for allocation nor double buffering
-				std::copy(first2, last2, data() + size());
-				const auto offset_first{first.ptr - data()};
-				const auto offset_mid{size() - (last - first)};
-				storage.set_size(size() + distance);
-				erase(first, last);
-				std::rotate(data() + offset_first, data() + offset_mid, data() + size());
-			} else { //do single allocation
-				storage_t tmp{size() - (last - first) + distance};
-				std::copy(first2, last2, tmp.data() + (first.ptr - data()));
-				std::move(data(), const_cast<char *>(first.ptr), tmp.data());
-				std::move(const_cast<char *>(last.ptr), data() + size(), tmp.data() + (first.ptr - data()) + distance);
-				tmp.set_size(size() - (last - first) + distance);
-				storage = std::move(tmp);
-			}
+			replace_range(static_cast<std::size_t>(first.ptr - data()), static_cast<std::size_t>(last - first), first2, last2);
 			return *this;
 		}
-		auto replace(const_iterator first, const_iterator last, std::string_view str) -> string & { return replace(first, last, str.begin(), str.end()); } //TODO: [C++??] precondition(begin() <= first && first <= last && last <= end());
+		auto replace(const_iterator first, const_iterator last, std::string_view str) -> string & { return replace(first, last, str.data(), str.data() + str.size()); } //TODO: [C++??] precondition(begin() <= first && first <= last && last <= end());
 		auto replace(const_iterator first, const_iterator last, std::initializer_list<char> ilist) -> string & { //TODO: [C++??] precondition(begin() <= first && first <= last && last <= end());
 			replace_no_aliasing(first, last, ilist.size(), [&](auto offset) { std::copy(ilist.begin(), ilist.end(), data() + offset); });
 			return *this;
@@ -540,12 +726,32 @@ namespace ptl {
 			return std::move(*this);
 		}
 
-		//TODO: [C++20] starts_with(string_view)
-		//TODO: [C++20] starts_with(char)
-		//TODO: [C++20] end_with(string_view)
-		//TODO: [C++20] end_with(char)
-		//TODO: [C++23] contains(string_view)
-		//TODO: [C++23] contains(char)
+		//! @brief find first occurrence of a substring
+		//! @note all searches are forwarded to ptl::string_ref
+		auto find(std::string_view str, size_type pos = 0) const noexcept -> size_type { return ref().find(str, pos); }
+		auto find(char ch, size_type pos = 0) const noexcept -> size_type { return ref().find(ch, pos); }
+		auto rfind(std::string_view str, size_type pos = npos) const noexcept -> size_type { return ref().rfind(str, pos); }
+		auto rfind(char ch, size_type pos = npos) const noexcept -> size_type { return ref().rfind(ch, pos); }
+		auto find_first_of(std::string_view set, size_type pos = 0) const noexcept -> size_type { return ref().find_first_of(set, pos); }
+		auto find_first_of(char ch, size_type pos = 0) const noexcept -> size_type { return ref().find_first_of(ch, pos); }
+		auto find_last_of(std::string_view set, size_type pos = npos) const noexcept -> size_type { return ref().find_last_of(set, pos); }
+		auto find_last_of(char ch, size_type pos = npos) const noexcept -> size_type { return ref().find_last_of(ch, pos); }
+		auto find_first_not_of(std::string_view set, size_type pos = 0) const noexcept -> size_type { return ref().find_first_not_of(set, pos); }
+		auto find_first_not_of(char ch, size_type pos = 0) const noexcept -> size_type { return ref().find_first_not_of(ch, pos); }
+		auto find_last_not_of(std::string_view set, size_type pos = npos) const noexcept -> size_type { return ref().find_last_not_of(set, pos); }
+		auto find_last_not_of(char ch, size_type pos = npos) const noexcept -> size_type { return ref().find_last_not_of(ch, pos); }
+
+		auto starts_with(std::string_view str) const noexcept -> bool { return ref().starts_with(str); }
+		auto starts_with(char ch) const noexcept -> bool { return ref().starts_with(ch); }
+		auto ends_with(std::string_view str) const noexcept -> bool { return ref().ends_with(str); }
+		auto ends_with(char ch) const noexcept -> bool { return ref().ends_with(ch); }
+		auto contains(std::string_view str) const noexcept -> bool { return ref().contains(str); }
+		auto contains(char ch) const noexcept -> bool { return ref().contains(ch); }
+
+		template<typename Integer>
+		auto parse_integer(Integer & value, int base = 10) const noexcept -> bool { return ref().parse_integer(value, base); }
+		template<typename Float>
+		auto parse_float(Float & value, std::chars_format fmt = std::chars_format::general) const noexcept -> bool { return ref().parse_float(value, fmt); }
 
 		operator std::string_view() const noexcept {
 			if(empty()) return {};
@@ -627,6 +833,6 @@ namespace ptl {
 namespace std {
 	template<>
 	struct hash<ptl::string> {
-		auto operator()(const ptl::string & self) const noexcept -> std::size_t { return std::hash<std::string_view>{}(self); }
+		auto operator()(const ptl::string & self) const noexcept -> std::size_t { return static_cast<std::size_t>(ptl::hash_bytes(self.data(), self.size())); }
 	};
 }
@@ -0,0 +1,193 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <new>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "hash.hpp"
+#include "vector.hpp"
+#include "string_ref.hpp"
+#include "allocation_policy.hpp"
+
+namespace ptl {
+	namespace internal_string_interner {
+		//precedes the characters of every interned string
+		struct header final {
+			std::uint64_t hash;
+			std::size_t size;
+		};
+		static_assert(sizeof(header) % alignof(header) == 0);
+
+		inline
+		auto header_of(const char * ptr) noexcept -> const header & { return *reinterpret_cast<const header *>(ptr - sizeof(header)); }
+
+		inline
+		auto hash(std::string_view str) noexcept -> std::uint64_t { return hash_bytes(str.data(), str.size()); }
+	}
+
+	class string_interner;
+
+	//! @brief handle to a string stored in a string_interner
+	//! @note equal strings interned by the same interner share a handle => comparison is a pointer comparison
+	//! @note a default constructed handle represents the empty string
+	//! @attention handles are only valid as long as the interner they were obtained from
+	class interned_string final {
+		friend string_interner;
+
+		const char * ptr{nullptr};
+
+		explicit
+		interned_string(const char * ptr) noexcept : ptr{ptr} {}
+	public:
+		interned_string() noexcept =default;
+
+		auto data() const noexcept -> const char * { return ptr ? ptr : ""; }
+		auto c_str() const noexcept -> const char * { return data(); }
+
+		[[nodiscard]]
+		auto empty() const noexcept -> bool { return !ptr; }
+		auto size() const noexcept -> std::size_t { return ptr ? internal_string_interner::header_of(ptr).size : 0; }
+
+		//! @returns cached result of ptl::hash_bytes
+		auto hash() const noexcept -> std::uint64_t { return ptr ? internal_string_interner::header_of(ptr).hash : internal_string_interner::hash({}); }
+
+		friend
+		auto operator==(const interned_string & lhs, const interned_string & rhs) noexcept -> bool { return lhs.ptr == rhs.ptr; }
+		friend
+		auto operator!=(const interned_string & lhs, const interned_string & rhs) noexcept -> bool { return !(lhs == rhs); } //TODO: [C++20] remove as implicitly generated
+
+		//! @brief convert to ptl::string_ref
+		operator string_ref() const noexcept { return {data(), size()}; }
+		//! @brief convert to std::string_view
+		operator std::string_view() const noexcept { return {data(), size()}; }
+	};
+	static_assert(sizeof(interned_string) == sizeof(void *));
+
+	//! @brief thread-safe table storing each unique string exactly once
+	//! @note strings are distributed over independently locked shards and stored in per-shard arenas
+	//! @note interned strings are never released before the interner is destroyed
+	//! @attention uses std::mutex, which requires linking the platform's thread library on some platforms (e.g. Threads::Threads in CMake)
+	class string_interner final {
+		struct alignas(64) shard final { //prevent false sharing between shards
+			mutable std::mutex mutex;
+			arena_policy arena;
+			vector<const char *> slots; //open addressing with linear probing, nullptr marks a free slot
+			std::size_t count{0}, bytes{0};
+
+			//slot containing str or the free slot where it would be inserted
+			auto lookup(std::string_view str, std::uint64_t hash) const noexcept -> std::size_t {
+				const auto mask{slots.size() - 1};
+				for(auto index{static_cast<std::size_t>(hash) & mask};; index = (index + 1) & mask) {
+					const auto ptr{slots[index]};
+					if(!ptr) return index;
+					const auto & h{internal_string_interner::header_of(ptr)};
+					if(h.hash == hash && h.size == str.size() && std::memcmp(ptr, str.data(), str.size()) == 0) return index;
+				}
+			}
+
+			void grow() {
+				vector<const char *> tmp(slots.size() * 2, nullptr);
+				const auto mask{tmp.size() - 1};
+				for(const auto ptr : slots)
+					if(ptr) {
+						auto index{static_cast<std::size_t>(internal_string_interner::header_of(ptr).hash) & mask};
+						while(tmp[index]) index = (index + 1) & mask;
+						tmp[index] = ptr;
+					}
+				slots.swap(tmp);
+			}
+
+			auto insert(std::string_view str, std::uint64_t hash) -> const char * {
+				const auto size{sizeof(internal_string_interner::header) + str.size() + 1};
+				const auto memory{static_cast<unsigned char *>(arena.allocate(&arena, size))};
+				if(!memory) throw std::bad_alloc{};
+				new(memory) internal_string_interner::header{hash, str.size()};
+				const auto ptr{reinterpret_cast<char *>(memory + sizeof(internal_string_interner::header))};
+				std::memcpy(ptr, str.data(), str.size());
+				ptr[str.size()] = 0;
+				++count;
+				bytes += internal_allocation_policy::align(size);
+				return ptr;
+			}
+		};
+
+		std::unique_ptr<shard[]> shards;
+		std::size_t shard_count{1};
+		unsigned shift{64}; //shards are selected by the high bits of a hash, slots by the low bits
+
+		auto shard_of(std::uint64_t hash) const noexcept -> shard & { return shards[shard_count == 1 ? 0 : static_cast<std::size_t>(hash >> shift)]; }
+	public:
+		//! @param[in] shard_count number of independently locked shards, rounded up to a power of two
+		explicit
+		string_interner(std::size_t shard_count = 16) {
+			while(this->shard_count < shard_count) {
+				this->shard_count *= 2;
+				--shift;
+			}
+			shards = std::make_unique<shard[]>(this->shard_count);
+			for(std::size_t i{0}; i < this->shard_count; ++i) shards[i].slots.resize(16, nullptr);
+		}
+		string_interner(const string_interner &) =delete;
+		auto operator=(const string_interner &) -> string_interner & =delete;
+		~string_interner() noexcept =default;
+
+		//! @brief obtain the handle of str, storing a copy of str if it was not interned before
+		auto intern(std::string_view str) -> interned_string {
+			if(str.empty()) return {};
+			const auto hash{internal_string_interner::hash(str)};
+			auto & s{shard_of(hash)};
+			const std::lock_guard lock{s.mutex};
+			auto index{s.lookup(str, hash)};
+			if(s.slots[index]) return interned_string{s.slots[index]};
+			if((s.count + 1) * 2 > s.slots.size()) { //keep the load factor below 50% to keep probe sequences short
+				s.grow();
+				index = s.lookup(str, hash);
+			}
+			return interned_string{s.slots[index] = s.insert(str, hash)};
+		}
+
+		//! @brief obtain the handle of str without interning it
+		//! @returns empty handle if str was not interned before
+		auto find(std::string_view str) const -> interned_string {
+			if(str.empty()) return {};
+			const auto hash{internal_string_interner::hash(str)};
+			const auto & s{shard_of(hash)};
+			const std::lock_guard lock{s.mutex};
+			return interned_string{s.slots[s.lookup(str, hash)]};
+		}
+
+		//! @returns number of unique strings
+		auto size() const -> std::size_t {
+			std::size_t result{0};
+			for(std::size_t i{0}; i < shard_count; ++i) {
+				const std::lock_guard lock{shards[i].mutex};
+				result += shards[i].count;
+			}
+			return result;
+		}
+
+		//! @returns number of bytes occupied by interned strings (including their cached size and hash) and the lookup tables
+		auto memory_usage() const -> std::size_t {
+			std::size_t result{0};
+			for(std::size_t i{0}; i < shard_count; ++i) {
+				const std::lock_guard lock{shards[i].mutex};
+				result += shards[i].bytes + shards[i].slots.capacity() * sizeof(const char *);
+			}
+			return result;
+		}
+	};
+}
+
+namespace std {
+	template<>
+	struct hash<ptl::interned_string> {
+		auto operator()(const ptl::interned_string & self) const noexcept -> std::size_t { return static_cast<std::size_t>(self.hash()); }
+	};
+}
@@ -6,14 +6,379 @@
 
 #pragma once
 #include <limits>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
 #include <stdexcept>
 #include <string_view>
+#include <type_traits>
+#include "hash.hpp"
+#include "internal/utils.hpp"
 
 namespace ptl {
+	namespace internal_string_ref {
+		using internal_utils::is_constant_evaluated;
+
+		//lookup table for the character sets of find_first_of & co.
+		struct char_set final {
+			bool values[256]{};
+
+			constexpr
+			char_set(const char * first, const char * last) noexcept { for(; first != last; ++first) values[static_cast<unsigned char>(*first)] = true; }
+
+			constexpr
+			auto contains(char ch) const noexcept -> bool { return values[static_cast<unsigned char>(ch)]; }
+		};
+
+		//all functions search [first, last) and return nullptr if nothing was found
+		constexpr
+		auto find(const char * first, const char * last, char ch) noexcept -> const char * {
+			for(; first != last; ++first) if(*first == ch) return first;
+			return nullptr;
+		}
+
+		constexpr
+		auto rfind(const char * first, const char * last, char ch) noexcept -> const char * {
+			while(first != last) if(*--last == ch) return last;
+			return nullptr;
+		}
+
+		constexpr
+		auto find(const char * first, const char * last, const char * str, std::size_t size) noexcept -> const char * { //TODO: [C++??] precondition(size >= 2 && last - first >= size);
+			for(const auto end{last - size + 1}; (first = find(first, end, *str)); ++first)
+				if(std::char_traits<char>::compare(first + 1, str + 1, size - 1) == 0) return first;
+			return nullptr;
+		}
+
+		constexpr
+		auto rfind(const char * first, const char * last, const char * str, std::size_t size) noexcept -> const char * { //TODO: [C++??] precondition(size >= 2 && last - first >= size);
+			for(auto end{last - size + 1}; (end = rfind(first, end, *str)); )
+				if(std::char_traits<char>::compare(end + 1, str + 1, size - 1) == 0) return end;
+			return nullptr;
+		}
+
+		template<bool Contained>
+		constexpr
+		auto find_of(const char * first, const char * last, const char * set, std::size_t size) noexcept -> const char * {
+			const char_set table{set, set + size};
+			for(; first != last; ++first) if(table.contains(*first) == Contained) return first;
+			return nullptr;
+		}
+
+		template<bool Contained>
+		constexpr
+		auto rfind_of(const char * first, const char * last, const char * set, std::size_t size) noexcept -> const char * {
+			const char_set table{set, set + size};
+			while(first != last) if(table.contains(*--last) == Contained) return last;
+			return nullptr;
+		}
+
+	#if defined(PTL_INTERNAL_SSE2)
+		//every kernel compares whole blocks, bit i of a mask corresponds to character i of a block
+		namespace simd {
+		#if defined(__AVX2__)
+			using block = __m256i;
+
+			inline
+			constexpr
+			std::size_t block_size{32};
+
+			inline
+			auto load(const char * ptr) noexcept -> block { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+
+			inline
+			auto broadcast(char ch) noexcept -> block { return _mm256_set1_epi8(ch); }
+
+			inline
+			auto equal(block lhs, block rhs) noexcept -> block { return _mm256_cmpeq_epi8(lhs, rhs); }
+
+			inline
+			auto bit_and(block lhs, block rhs) noexcept -> block { return _mm256_and_si256(lhs, rhs); }
+
+			inline
+			auto bit_or(block lhs, block rhs) noexcept -> block { return _mm256_or_si256(lhs, rhs); }
+
+			inline
+			auto bit_not(block value) noexcept -> block { return _mm256_xor_si256(value, _mm256_set1_epi8(-1)); }
+
+			inline
+			auto to_mask(block value) noexcept -> std::uint32_t { return static_cast<std::uint32_t>(_mm256_movemask_epi8(value)); }
+		#else
+			using block = __m128i;
+
+			inline
+			constexpr
+			std::size_t block_size{16};
+
+			inline
+			auto load(const char * ptr) noexcept -> block { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)); }
+
+			inline
+			auto broadcast(char ch) noexcept -> block { return _mm_set1_epi8(ch); }
+
+			inline
+			auto equal(block lhs, block rhs) noexcept -> block { return _mm_cmpeq_epi8(lhs, rhs); }
+
+			inline
+			auto bit_and(block lhs, block rhs) noexcept -> block { return _mm_and_si128(lhs, rhs); }
+
+			inline
+			auto bit_or(block lhs, block rhs) noexcept -> block { return _mm_or_si128(lhs, rhs); }
+
+			inline
+			auto bit_not(block value) noexcept -> block { return _mm_xor_si128(value, _mm_set1_epi8(-1)); }
+
+			inline
+			auto to_mask(block value) noexcept -> std::uint32_t { return static_cast<std::uint32_t>(_mm_movemask_epi8(value)); }
+		#endif
+
+			inline
+			auto first_bit(std::uint32_t mask) noexcept -> unsigned { return internal_utils::countr_zero(mask); } //TODO: [C++??] precondition(mask != 0);
+
+			inline
+			auto last_bit(std::uint32_t mask) noexcept -> unsigned { return 63 - internal_utils::countl_zero(mask); } //TODO: [C++??] precondition(mask != 0);
+
+			//calls matcher for each block of [first, last), the final block overlaps with its predecessor instead of falling back to scalar code
+			//matcher returns a block whose matching characters have all bits set
+			template<typename Matcher>
+			auto find(const char * first, const char * last, Matcher matcher) noexcept -> const char * { //TODO: [C++??] precondition(last - first >= block_size);
+				for(; static_cast<std::size_t>(last - first) > 4 * block_size; first += 4 * block_size) { //unrolled to test four blocks with a single branch
+					const auto b0{matcher(first)}, b1{matcher(first + block_size)}, b2{matcher(first + 2 * block_size)}, b3{matcher(first + 3 * block_size)};
+					if(!to_mask(bit_or(bit_or(b0, b1), bit_or(b2, b3)))) continue;
+					if(const auto mask{to_mask(b0)}) return first + first_bit(mask);
+					if(const auto mask{to_mask(b1)}) return first + block_size + first_bit(mask);
+					if(const auto mask{to_mask(b2)}) return first + 2 * block_size + first_bit(mask);
+					return first + 3 * block_size + first_bit(to_mask(b3));
+				}
+				for(; static_cast<std::size_t>(last - first) > block_size; first += block_size)
+					if(const auto mask{to_mask(matcher(first))}) return first + first_bit(mask);
+				const auto skipped{block_size - static_cast<std::size_t>(last - first)}; //characters that have already been checked
+				if(const auto mask{to_mask(matcher(last - block_size)) >> skipped}) return first + first_bit(mask);
+				return nullptr;
+			}
+
+			template<typename Matcher>
+			auto rfind(const char * first, const char * last, Matcher matcher) noexcept -> const char * { //TODO: [C++??] precondition(last - first >= block_size);
+				for(; static_cast<std::size_t>(last - first) > 4 * block_size; last -= 4 * block_size) { //unrolled to test four blocks with a single branch
+					const auto b0{matcher(last - block_size)}, b1{matcher(last - 2 * block_size)}, b2{matcher(last - 3 * block_size)}, b3{matcher(last - 4 * block_size)};
+					if(!to_mask(bit_or(bit_or(b0, b1), bit_or(b2, b3)))) continue;
+					if(const auto mask{to_mask(b0)}) return last - block_size + last_bit(mask);
+					if(const auto mask{to_mask(b1)}) return last - 2 * block_size + last_bit(mask);
+					if(const auto mask{to_mask(b2)}) return last - 3 * block_size + last_bit(mask);
+					return last - 4 * block_size + last_bit(to_mask(b3));
+				}
+				for(; static_cast<std::size_t>(last - first) > block_size; last -= block_size)
+					if(const auto mask{to_mask(matcher(last - block_size))}) return last - block_size + last_bit(mask);
+				const auto skipped{block_size - static_cast<std::size_t>(last - first)}; //characters that have already been checked
+				if(const auto mask{static_cast<std::uint32_t>(std::uint64_t{to_mask(matcher(first))} << skipped & ((std::uint64_t{1} << block_size) - 1))}) return first + last_bit(mask) - skipped;
+				return nullptr;
+			}
+
+			//candidates have to match the first and last character of str and are verified afterwards
+			struct substring_matcher final {
+				block head, tail;
+				std::size_t offset;
+
+				substring_matcher(const char * str, std::size_t size) noexcept : head{broadcast(str[0])}, tail{broadcast(str[size - 1])}, offset{size - 1} {}
+
+				auto operator()(const char * ptr) const noexcept -> block { return bit_and(equal(load(ptr), head), equal(load(ptr + offset), tail)); }
+			};
+
+			inline
+			auto find(const char * first, const char * last, const char * str, std::size_t size) noexcept -> const char * { //TODO: [C++??] precondition(size >= 2 && last - first >= size);
+				const substring_matcher matcher{str, size};
+				for(const auto end{last - size + 1}; static_cast<std::size_t>(end - first) >= block_size; ++first) { //candidates are [first, end)
+					first = find(first, end, matcher);
+					if(!first || std::memcmp(first + 1, str + 1, size - 2) == 0) return first;
+				}
+				return internal_string_ref::find(first, last, str, size);
+			}
+
+			inline
+			auto rfind(const char * first, const char * last, const char * str, std::size_t size) noexcept -> const char * { //TODO: [C++??] precondition(size >= 2 && last - first >= size);
+				const substring_matcher matcher{str, size};
+				for(auto end{last - size + 1}; static_cast<std::size_t>(end - first) >= block_size; ) { //candidates are [first, end)
+					end = rfind(first, end, matcher);
+					if(!end || std::memcmp(end + 1, str + 1, size - 2) == 0) return end;
+					last = end + size - 1;
+				}
+				return internal_string_ref::rfind(first, last, str, size);
+			}
+
+			//sets larger than this are faster to search with a lookup table
+			inline
+			constexpr
+			std::size_t max_set_size{16};
+
+			template<bool Contained>
+			struct set_matcher final {
+				block values[max_set_size];
+				std::size_t size;
+
+				set_matcher(const char * set, std::size_t size) noexcept : size{size} { for(std::size_t i{0}; i < size; ++i) values[i] = broadcast(set[i]); } //TODO: [C++??] precondition(size <= max_set_size);
+
+				auto operator()(const char * ptr) const noexcept -> block {
+					const auto value{load(ptr)};
+					auto result{equal(value, values[0])};
+					for(std::size_t i{1}; i < size; ++i) result = bit_or(result, equal(value, values[i]));
+					return Contained ? result : bit_not(result);
+				}
+			};
+		}
+	#endif
+
+		//dispatch to the SIMD kernels if the input is large enough
+		inline
+		constexpr
+		auto find_char(const char * first, const char * last, char ch) noexcept -> const char * {
+		#if defined(PTL_INTERNAL_SSE2)
+			if(!is_constant_evaluated() && static_cast<std::size_t>(last - first) >= simd::block_size) return simd::find(first, last, [needle{simd::broadcast(ch)}](const char * ptr) { return simd::equal(simd::load(ptr), needle); });
+		#endif
+			return find(first, last, ch);
+		}
+
+		inline
+		constexpr
+		auto rfind_char(const char * first, const char * last, char ch) noexcept -> const char * {
+		#if defined(PTL_INTERNAL_SSE2)
+			if(!is_constant_evaluated() && static_cast<std::size_t>(last - first) >= simd::block_size) return simd::rfind(first, last, [needle{simd::broadcast(ch)}](const char * ptr) { return simd::equal(simd::load(ptr), needle); });
+		#endif
+			return rfind(first, last, ch);
+		}
+
+		inline
+		constexpr
+		auto find_str(const char * first, const char * last, const char * str, std::size_t size) noexcept -> const char * { //TODO: [C++??] precondition(size >= 2 && last - first >= size);
+		#if defined(PTL_INTERNAL_SSE2)
+			if(!is_constant_evaluated()) return simd::find(first, last, str, size);
+		#endif
+			return find(first, last, str, size);
+		}
+
+		inline
+		constexpr
+		auto rfind_str(const char * first, const char * last, const char * str, std::size_t size) noexcept -> const char * { //TODO: [C++??] precondition(size >= 2 && last - first >= size);
+		#if defined(PTL_INTERNAL_SSE2)
+			if(!is_constant_evaluated()) return simd::rfind(first, last, str, size);
+		#endif
+			return rfind(first, last, str, size);
+		}
+
+		template<bool Contained>
+		constexpr
+		auto find_set(const char * first, const char * last, const char * set, std::size_t size) noexcept -> const char * {
+		#if defined(PTL_INTERNAL_SSE2)
+			if(!is_constant_evaluated() && static_cast<std::size_t>(last - first) >= simd::block_size && 0 < size && size <= simd::max_set_size) return simd::find(first, last, simd::set_matcher<Contained>{set, size});
+		#endif
+			return find_of<Contained>(first, last, set, size);
+		}
+
+		template<bool Contained>
+		constexpr
+		auto rfind_set(const char * first, const char * last, const char * set, std::size_t size) noexcept -> const char * {
+		#if defined(PTL_INTERNAL_SSE2)
+			if(!is_constant_evaluated() && static_cast<std::size_t>(last - first) >= simd::block_size && 0 < size && size <= simd::max_set_size) return simd::rfind(first, last, simd::set_matcher<Contained>{set, size});
+		#endif
+			return rfind_of<Contained>(first, last, set, size);
+		}
+
+		using internal_utils::countr_zero;
+
+		//split ranges inspect windows of this many candidates at once and consume the resulting mask bit by bit
+		inline
+		constexpr
+		std::size_t window_size{64};
+
+		//bit i of the result is set if pred(ptr[i])
+		template<typename Predicate>
+		auto window_mask(const char * ptr, std::size_t count, Predicate pred) noexcept -> std::uint64_t { //TODO: [C++??] precondition(count <= window_size);
+			std::uint64_t result{0};
+			for(std::size_t i{0}; i < count; ++i) result |= static_cast<std::uint64_t>(pred(ptr[i])) << i;
+			return result;
+		}
+
+	#if defined(PTL_INTERNAL_SSE2)
+		namespace simd {
+			template<typename Matcher>
+			auto window_mask(const char * ptr, Matcher matcher) noexcept -> std::uint64_t {
+				std::uint64_t result{0};
+				for(std::size_t i{0}; i < window_size; i += block_size) result |= std::uint64_t{to_mask(matcher(ptr + i))} << i;
+				return result;
+			}
+		}
+	#endif
+
+		//delimiters of split ranges: size() is the length of a delimiter, mask(ptr, count) flags every candidate in [ptr, ptr + count) and verify(ptr) confirms a candidate
+		struct char_delimiter final {
+			char ch;
+
+			constexpr
+			auto size() const noexcept -> std::size_t { return 1; }
+
+			auto mask(const char * ptr, std::size_t count) const noexcept -> std::uint64_t {
+			#if defined(PTL_INTERNAL_SSE2)
+				if(count == window_size) return simd::window_mask(ptr, [needle{simd::broadcast(ch)}](const char * ptr) { return simd::equal(simd::load(ptr), needle); });
+			#endif
+				return window_mask(ptr, count, [&](char c) { return c == ch; });
+			}
+
+			constexpr
+			auto verify(const char *) const noexcept -> bool { return true; }
+		};
+
+		//candidates match the first and last character, the delimiter must outlive the range
+		struct string_delimiter final {
+			std::string_view str;
+
+			constexpr
+			auto size() const noexcept -> std::size_t { return str.size(); }
+
+			auto mask(const char * ptr, std::size_t count) const noexcept -> std::uint64_t { //TODO: [C++??] precondition(!str.empty());
+			#if defined(PTL_INTERNAL_SSE2)
+				if(count == window_size) return simd::window_mask(ptr, simd::substring_matcher{str.data(), str.size()});
+			#endif
+				std::uint64_t result{0};
+				for(std::size_t i{0}; i < count; ++i) result |= static_cast<std::uint64_t>(ptr[i] == str.front() && ptr[i + str.size() - 1] == str.back()) << i;
+				return result;
+			}
+
+			auto verify(const char * ptr) const noexcept -> bool { return std::memcmp(ptr, str.data(), str.size()) == 0; }
+		};
+
+		//copies the set, so any temporary may be passed to split_any
+		struct set_delimiter final {
+			char_set table;
+			char values[16];
+			std::size_t length; //0 if the set is too large to be stored in values
+
+			set_delimiter(std::string_view set) noexcept : table{set.data(), set.data() + set.size()}, values{}, length{set.size() <= sizeof(values) ? set.size() : 0} { for(std::size_t i{0}; i < length; ++i) values[i] = set[i]; }
+
+			constexpr
+			auto size() const noexcept -> std::size_t { return 1; }
+
+			auto mask(const char * ptr, std::size_t count) const noexcept -> std::uint64_t {
+			#if defined(PTL_INTERNAL_SSE2)
+				static_assert(sizeof(values) == simd::max_set_size);
+				if(count == window_size && 0 < length) return simd::window_mask(ptr, simd::set_matcher<true>{values, length});
+			#endif
+				return window_mask(ptr, count, [&](char c) { return table.contains(c); });
+			}
+
+			constexpr
+			auto verify(const char *) const noexcept -> bool { return true; }
+		};
+
+		template<typename Delimiter, bool Lines = false>
+		class split_range;
+	}
+
 	//! @brief a read-only, non-owning reference to a string
 	//! @attention the referenced string is not guaranteed to be null-terminated!
 	class string_ref final {
 		const char * first{nullptr}, * last{nullptr};
+
+		constexpr
+		auto to_index(const char * ptr) const noexcept -> std::size_t { return ptr ? static_cast<std::size_t>(ptr - data()) : npos; }
 	public:
 		using traits_type            = std::char_traits<char>;
 		using value_type             = char;
@@ -116,6 +481,10 @@ namespace ptl {
 		using reverse_iterator       = std::reverse_iterator<iterator>;
 		using const_reverse_iterator = reverse_iterator;
 
+		static
+		constexpr
+		size_type npos{static_cast<size_type>(-1)};
+
 		constexpr
 		string_ref() noexcept =default;
 
@@ -173,6 +542,118 @@ namespace ptl {
 		constexpr
 		auto substr(size_type offset, size_type count) const noexcept -> string_ref { return {data() + offset, count}; } //TODO: [C++??] precondition(offset + count <= size());
 
+		//! @brief find first occurrence of a substring
+		//! @param[in] str substring to search for
+		//! @param[in] pos position to start the search at
+		//! @returns position of the first character of the found substring or npos if no such substring exists
+		//! @note all searches use SSE2/AVX2 if available and produce identical results on every platform
+		constexpr
+		auto find(std::string_view str, size_type pos = 0) const noexcept -> size_type {
+			if(pos > size() || str.size() > size() - pos) return npos;
+			if(str.size() < 2) return str.empty() ? pos : find(str[0], pos);
+			return to_index(internal_string_ref::find_str(data() + pos, data() + size(), str.data(), str.size()));
+		}
+		constexpr
+		auto find(char ch, size_type pos = 0) const noexcept -> size_type { return pos < size() ? to_index(internal_string_ref::find_char(data() + pos, data() + size(), ch)) : npos; }
+
+		//! @brief find last occurrence of a substring
+		//! @param[in] str substring to search for
+		//! @param[in] pos position of the last character that may start the substring
+		//! @returns position of the first character of the found substring or npos if no such substring exists
+		constexpr
+		auto rfind(std::string_view str, size_type pos = npos) const noexcept -> size_type {
+			if(str.size() > size()) return npos;
+			pos = std::min(pos, size() - str.size());
+			if(str.size() < 2) return str.empty() ? pos : rfind(str[0], pos);
+			return to_index(internal_string_ref::rfind_str(data(), data() + pos + str.size(), str.data(), str.size()));
+		}
+		constexpr
+		auto rfind(char ch, size_type pos = npos) const noexcept -> size_type { return empty() ? npos : to_index(internal_string_ref::rfind_char(data(), data() + std::min(pos, size() - 1) + 1, ch)); }
+
+		//! @brief find first character equal to any of the characters in set
+		constexpr
+		auto find_first_of(std::string_view set, size_type pos = 0) const noexcept -> size_type {
+			if(set.size() == 1) return find(set[0], pos);
+			return pos < size() ? to_index(internal_string_ref::find_set<true>(data() + pos, data() + size(), set.data(), set.size())) : npos;
+		}
+		constexpr
+		auto find_first_of(char ch, size_type pos = 0) const noexcept -> size_type { return find(ch, pos); }
+
+		//! @brief find last character equal to any of the characters in set
+		constexpr
+		auto find_last_of(std::string_view set, size_type pos = npos) const noexcept -> size_type {
+			if(set.size() == 1) return rfind(set[0], pos);
+			return empty() ? npos : to_index(internal_string_ref::rfind_set<true>(data(), data() + std::min(pos, size() - 1) + 1, set.data(), set.size()));
+		}
+		constexpr
+		auto find_last_of(char ch, size_type pos = npos) const noexcept -> size_type { return rfind(ch, pos); }
+
+		//! @brief find first character not equal to any of the characters in set
+		constexpr
+		auto find_first_not_of(std::string_view set, size_type pos = 0) const noexcept -> size_type { return pos < size() ? to_index(internal_string_ref::find_set<false>(data() + pos, data() + size(), set.data(), set.size())) : npos; }
+		constexpr
+		auto find_first_not_of(char ch, size_type pos = 0) const noexcept -> size_type { return find_first_not_of(std::string_view{&ch, 1}, pos); }
+
+		//! @brief find last character not equal to any of the characters in set
+		constexpr
+		auto find_last_not_of(std::string_view set, size_type pos = npos) const noexcept -> size_type { return empty() ? npos : to_index(internal_string_ref::rfind_set<false>(data(), data() + std::min(pos, size() - 1) + 1, set.data(), set.size())); }
+		constexpr
+		auto find_last_not_of(char ch, size_type pos = npos) const noexcept -> size_type { return find_last_not_of(std::string_view{&ch, 1}, pos); }
+
+		constexpr
+		auto starts_with(std::string_view str) const noexcept -> bool { return size() >= str.size() && std::string_view{data(), str.size()} == str; }
+		constexpr
+		auto starts_with(char ch) const noexcept -> bool { return !empty() && front() == ch; }
+
+		constexpr
+		auto ends_with(std::string_view str) const noexcept -> bool { return size() >= str.size() && std::string_view{data() + size() - str.size(), str.size()} == str; }
+		constexpr
+		auto ends_with(char ch) const noexcept -> bool { return !empty() && back() == ch; }
+
+		constexpr
+		auto contains(std::string_view str) const noexcept -> bool { return find(str) != npos; }
+		constexpr
+		auto contains(char ch) const noexcept -> bool { return find(ch) != npos; }
+
+		//! @brief parse the whole string as an integer in base using std::from_chars (locale independent, neither whitespace nor '+' are accepted)
+		//! @returns true if all characters were consumed and the result is representable by Integer, otherwise value is unchanged
+		template<typename Integer>
+		auto parse_integer(Integer & value, int base = 10) const noexcept -> bool { //TODO: [C++??] precondition(2 <= base && base <= 36);
+			static_assert(std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>);
+			Integer tmp;
+			const auto [ptr, ec]{std::from_chars(data(), data() + size(), tmp, base)};
+			if(ec != std::errc{} || ptr != data() + size()) return false;
+			value = tmp;
+			return true;
+		}
+
+		//! @brief parse the whole string as a floating point number in format fmt using std::from_chars (locale independent, neither whitespace nor '+' are accepted)
+		//! @returns true if all characters were consumed and the result is representable by Float, otherwise value is unchanged
+		template<typename Float>
+		auto parse_float(Float & value, std::chars_format fmt = std::chars_format::general) const noexcept -> bool {
+			static_assert(std::is_floating_point_v<Float>);
+			Float tmp;
+			const auto [ptr, ec]{std::from_chars(data(), data() + size(), tmp, fmt)};
+			if(ec != std::errc{} || ptr != data() + size()) return false;
+			value = tmp;
+			return true;
+		}
+
+		//! @brief lazily split into the pieces separated by delim
+		//! @note consecutive delimiters yield empty pieces, an empty string yields a single empty piece
+		//! @note delimiters are located 64 characters at a time using SSE2/AVX2 if available, pieces never allocate
+		auto split(char delim) const noexcept -> internal_string_ref::split_range<internal_string_ref::char_delimiter>;
+		//! @attention delim must outlive the returned range
+		//! @note an empty delim never matches
+		auto split(std::string_view delim) const noexcept -> internal_string_ref::split_range<internal_string_ref::string_delimiter>;
+
+		//! @brief lazily split into the pieces separated by any of the characters in set
+		auto split_any(std::string_view set) const noexcept -> internal_string_ref::split_range<internal_string_ref::set_delimiter>;
+
+		//! @brief lazily split into lines terminated by '\n' or "\r\n", following the semantics of std::getline
+		//! @note the terminators are not part of the lines, an empty string contains no lines
+		auto lines() const noexcept -> internal_string_ref::split_range<internal_string_ref::char_delimiter, true>;
+
 		constexpr
 		auto begin() const noexcept -> iterator { return data(); }
 		constexpr
@@ -219,6 +700,105 @@ namespace ptl {
 	};
 	static_assert(sizeof(string_ref) == 2 * sizeof(const char *));
 
+	namespace internal_string_ref {
+		//lazy range over the pieces of [first, last), Lines additionally drops a final empty piece and a '\r' directly preceding a delimiter
+		template<typename Delimiter, bool Lines>
+		class split_range final {
+			const char * first, * last;
+			std::size_t candidates; //number of positions a delimiter may start at
+			bool empty, terminated; //terminated: the final delimiter was dropped
+			Delimiter delimiter;
+		public:
+			class iterator final {
+				friend split_range;
+
+				const split_range * range{nullptr};
+				const char * piece_first{nullptr}, * piece_last{nullptr};
+				std::size_t window{0}; //offset of the window the mask belongs to
+				std::uint64_t mask{0}; //candidates in the window that have not been visited yet
+
+				iterator(const split_range & range) noexcept : range{&range}, piece_first{range.first} {
+					if(range.candidates) mask = range.delimiter.mask(range.first, std::min(range.candidates, window_size));
+					piece_last = next();
+				}
+
+				//first delimiter that starts at or after piece_first, last if there is none
+				auto next() noexcept -> const char * {
+					const auto offset{static_cast<std::size_t>(piece_first - range->first)};
+					if(offset - window < window_size) mask &= ~std::uint64_t{0} << (offset - window);
+					else { //delimiters longer than a character may skip entire windows
+						window = offset;
+						mask = window < range->candidates ? range->delimiter.mask(range->first + window, std::min(range->candidates - window, window_size)) : 0;
+					}
+					for(;;) {
+						while(!mask) {
+							window += window_size;
+							if(window >= range->candidates) return range->last;
+							mask = range->delimiter.mask(range->first + window, std::min(range->candidates - window, window_size));
+						}
+						const auto ptr{range->first + window + countr_zero(mask)};
+						mask &= mask - 1;
+						if(range->delimiter.verify(ptr)) return ptr;
+					}
+				}
+			public:
+				//TODO: [C++20] using iterator_concept = std::forward_iterator_tag;
+				using iterator_category = std::input_iterator_tag;
+				using value_type        = string_ref;
+				using difference_type   = std::ptrdiff_t;
+				using pointer           = void;
+				using reference         = string_ref;
+
+				iterator() noexcept =default;
+
+				auto operator++() noexcept -> iterator & {
+					if(piece_last == range->last) *this = iterator{};
+					else {
+						piece_first = piece_last + range->delimiter.size();
+						piece_last = next();
+					}
+					return *this;
+				}
+				auto operator++(int) noexcept -> iterator {
+					auto tmp{*this};
+					++*this;
+					return tmp;
+				}
+
+				auto operator*() const noexcept -> reference {
+					if(Lines && piece_first != piece_last && piece_last[-1] == '\r' && (piece_last != range->last || range->terminated)) return {piece_first, static_cast<std::size_t>(piece_last - piece_first - 1)};
+					return {piece_first, static_cast<std::size_t>(piece_last - piece_first)};
+				}
+
+				friend
+				auto operator==(const iterator & lhs, const iterator & rhs) noexcept -> bool { return lhs.range == rhs.range && lhs.piece_first == rhs.piece_first; }
+				friend
+				auto operator!=(const iterator & lhs, const iterator & rhs) noexcept -> bool { return !(lhs == rhs); } //TODO: [C++20] remove as implicitly generated
+			};
+
+			split_range(const char * first, const char * last, Delimiter delimiter) noexcept : first{first}, last{last}, empty{Lines && first == last}, terminated{!empty && Lines && last[-1] == '\n'}, delimiter{delimiter} {
+				if(terminated) --this->last;
+				const auto size{static_cast<std::size_t>(this->last - first)};
+				candidates = 0 < delimiter.size() && delimiter.size() <= size ? size - delimiter.size() + 1 : 0;
+			}
+
+			auto begin() const noexcept -> iterator { return empty ? iterator{} : iterator{*this}; }
+			auto end() const noexcept -> iterator { return {}; }
+		};
+	}
+
+	inline
+	auto string_ref::split(char delim) const noexcept -> internal_string_ref::split_range<internal_string_ref::char_delimiter> { return {data(), data() + size(), internal_string_ref::char_delimiter{delim}}; }
+
+	inline
+	auto string_ref::split(std::string_view delim) const noexcept -> internal_string_ref::split_range<internal_string_ref::string_delimiter> { return {data(), data() + size(), internal_string_ref::string_delimiter{delim}}; }
+
+	inline
+	auto string_ref::split_any(std::string_view set) const noexcept -> internal_string_ref::split_range<internal_string_ref::set_delimiter> { return {data(), data() + size(), internal_string_ref::set_delimiter{set}}; }
+
+	inline
+	auto string_ref::lines() const noexcept -> internal_string_ref::split_range<internal_string_ref::char_delimiter, true> { return {data(), data() + size(), internal_string_ref::char_delimiter{'\n'}}; }
+
 	//TODO: [C++20] basic_string_view(It, End) -> basic_string_view<std::iter_value_t<It>>;
 	//TODO: [C++23] basic_string_view(R&&) -> basic_string_view<ranges::range_value_t<R>>;
 
@@ -232,7 +812,7 @@ namespace ptl {
 namespace std {
 	template<>
 	struct hash<ptl::string_ref> {
-		auto operator()(const ptl::string_ref & self) const noexcept -> std::size_t { return std::hash<std::string_view>{}(self); }
+		auto operator()(const ptl::string_ref & self) const noexcept -> std::size_t { return static_cast<std::size_t>(ptl::hash_bytes(self.data(), self.size())); }
 	};
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 #include <limits>
 #include <utility>
+#include <exception>
 #include <variant>
 #include <type_traits>
 
@@ -97,20 +98,97 @@ namespace ptl {
 			else return determine_type<Index - 1, Tail...>();
 		}
 
+		[[noreturn]]
+		inline
+		void unreachable() noexcept { //TODO: [C++23] replace with std::unreachable
+		#if defined(__GNUC__) || defined(__clang__)
+			__builtin_unreachable();
+		#elif defined(_MSC_VER)
+			__assume(false);
+		#else
+			std::terminate();
+		#endif
+		}
+
+		template<std::size_t Index>
+		using index_t = std::integral_constant<std::size_t, Index>;
+
+		//up to max_chain alternatives are dispatched by a chain of comparisons, up to max_switch by a switch (=> jump table), beyond that by a table of function pointers
+		//the first two are visible to the optimizer, allowing the function to be inlined into the caller
+		inline
+		constexpr
+		std::size_t max_chain{8}, max_switch{16};
+
+		template<typename Result, typename Function, std::size_t Head, std::size_t... Tail>
+		constexpr
+		auto dispatch_chain(std::index_sequence<Head, Tail...>, std::size_t type, Function & function) -> Result { //TODO: [C++??] precondition(Head <= type && type <= Head + sizeof...(Tail));
+			if constexpr(sizeof...(Tail) == 0) return function(index_t<Head>{});
+			else if(type == Head) return function(index_t<Head>{});
+			else return dispatch_chain<Result>(std::index_sequence<Tail...>{}, type, function);
+		}
+
+		template<std::size_t Index, std::size_t Count, typename Result, typename Function>
+		constexpr
+		auto dispatch_case(Function & function) -> Result {
+			if constexpr(Index < Count) return function(index_t<Index>{});
+			else unreachable();
+		}
+
+		template<std::size_t Count, typename Result, typename Function>
+		constexpr
+		auto dispatch_switch(std::size_t type, Function & function) -> Result { //TODO: [C++??] precondition(type < Count);
+			static_assert(Count <= max_switch);
+			switch(type) {
+				case  0: return dispatch_case< 0, Count, Result>(function);
+				case  1: return dispatch_case< 1, Count, Result>(function);
+				case  2: return dispatch_case< 2, Count, Result>(function);
+				case  3: return dispatch_case< 3, Count, Result>(function);
+				case  4: return dispatch_case< 4, Count, Result>(function);
+				case  5: return dispatch_case< 5, Count, Result>(function);
+				case  6: return dispatch_case< 6, Count, Result>(function);
+				case  7: return dispatch_case< 7, Count, Result>(function);
+				case  8: return dispatch_case< 8, Count, Result>(function);
+				case  9: return dispatch_case< 9, Count, Result>(function);
+				case 10: return dispatch_case<10, Count, Result>(function);
+				case 11: return dispatch_case<11, Count, Result>(function);
+				case 12: return dispatch_case<12, Count, Result>(function);
+				case 13: return dispatch_case<13, Count, Result>(function);
+				case 14: return dispatch_case<14, Count, Result>(function);
+				case 15: return dispatch_case<15, Count, Result>(function);
+				default: unreachable();
+			}
+		}
+
+		template<typename Result, typename Function, std::size_t... Indices>
+		constexpr
+		auto dispatch_table(std::index_sequence<Indices...>, std::size_t type, Function & function) -> Result { //TODO: [C++??] precondition(type < sizeof...(Indices));
+			using Dispatch = Result(*)(Function &);
+			constexpr Dispatch dispatch[]{+[](Function & function) -> Result { return function(index_t<Indices>{}); }...};
+			return dispatch[type](function);
+		}
+
+		//invoke function with index_t<type>, function must return the same type for all indices
+		template<std::size_t... Indices, typename Function>
+		constexpr
+		auto dispatch(std::index_sequence<Indices...> indices, std::size_t type, Function && function) -> decltype(auto) { //TODO: [C++??] precondition(type < sizeof...(Indices));
+			using Result = decltype(function(index_t<0>{}));
+			if constexpr(sizeof...(Indices) <= max_chain) return dispatch_chain<Result>(indices, type, function);
+			else if constexpr(sizeof...(Indices) <= max_switch) return dispatch_switch<sizeof...(Indices), Result>(type, function);
+			else return dispatch_table<Result>(indices, type, function);
+		}
+
 		template<bool Move, typename Storage, typename Visitor, std::size_t... Indices>
 		constexpr
-		auto visit(std::index_sequence<Indices...>, std::size_t type, Storage & storage, Visitor && visitor) -> decltype(auto) { //TODO: [C++??] precondition(storage.get(type) is valid);
+		auto visit(std::index_sequence<Indices...> indices, std::size_t type, Storage & storage, Visitor && visitor) -> decltype(auto) { //TODO: [C++??] precondition(storage.get(type) is valid);
 			using Type = typename Storage::value_type;
 			using Tmp1 = std::conditional_t<std::is_const_v<Storage>, const Type, Type>;
 			using Tmp2 = std::conditional_t<Move, Tmp1, Tmp1 &>;
 			using Result = decltype(std::declval<Visitor>()(std::declval<Tmp2>()));
-			using Dispatch = Result(*)(Storage &, Visitor &);
-			constexpr Dispatch dispatch[]{+[](Storage & storage, Visitor & visitor) -> Result {
-				auto ptr{storage.template get<Indices>()};
+			return dispatch(indices, type, [&](auto index) -> Result {
+				auto ptr{storage.template get<decltype(index)::value>()};
 				if constexpr(Move) return visitor(std::move(*ptr));
 				else return visitor(*ptr);
-			}...};
-			return dispatch[type](storage, visitor);
+			});
 		}
 
 		template<bool Move, typename Storage, typename... Visitors, std::size_t... Indices, typename = std::enable_if_t<(sizeof...(Visitors) > 1)>> //TODO: [C++20] replace with concepts/requires-clause
@@ -120,52 +198,35 @@ namespace ptl {
 			return visit<Move>(indices, type, storage, combined_visitor{std::forward<Visitors>(visitors)...});
 		}
 
-		template<std::size_t... Indices, typename Storage, typename... Args>
-		constexpr
-		void emplace(std::index_sequence<Indices...>, std::size_t type, Storage & storage, Args &&... args) {  //TODO: [C++??] precondition(union in storage is uninitialized);
-			using Dispatch = void(*)(Storage &, Args &&...);
-			constexpr Dispatch dispatch[]{+[](Storage & storage, Args &&... args) { storage.template set<Indices>(std::forward<Args>(args)...); }...};
-			dispatch[type](storage, std::forward<Args>(args)...);
-		}
-
 		template<bool Move, typename Storage, std::size_t... Indices>
 		constexpr
-		void assign(std::index_sequence<Indices...>, std::size_t type, Storage & lhs, std::conditional_t<Move, Storage, const Storage> & rhs) noexcept(Move) { //TODO: [C++??] precondition(lhs is uninitialized);
-			using Other = std::conditional_t<Move, Storage, const Storage>;
-			using Dispatch = void(*)(Storage &, Other &) noexcept(Move);
-			constexpr Dispatch dispatch[]{+[](Storage & lhs, Other & rhs) noexcept(Move) {
-				auto ptr{rhs.template get<Indices>()};
-				if constexpr(Move) lhs.template set<Indices>(std::move(*ptr));
-				else lhs.template set<Indices>(*ptr);
-			}...};
-			dispatch[type](lhs, rhs);
+		void assign(std::index_sequence<Indices...> indices, std::size_t type, Storage & lhs, std::conditional_t<Move, Storage, const Storage> & rhs) noexcept(Move) { //TODO: [C++??] precondition(lhs is uninitialized);
+			dispatch(indices, type, [&](auto index) {
+				auto ptr{rhs.template get<decltype(index)::value>()};
+				if constexpr(Move) lhs.template set<decltype(index)::value>(std::move(*ptr));
+				else lhs.template set<decltype(index)::value>(*ptr);
+			});
 		}
 
 		template<std::size_t... Indices, typename Storage>
 		constexpr
-		void destroy(std::index_sequence<Indices...>, std::size_t type, Storage & storage) { //TODO: [C++??] precondition(storage.get(type) is valid);
-			using Dispatch = void(*)(Storage &) noexcept;
-			constexpr Dispatch dispatch[]{+[](Storage & storage) noexcept { storage.template destroy<Indices>(); }...};
-			dispatch[type](storage);
+		void destroy(std::index_sequence<Indices...> indices, std::size_t type, Storage & storage) noexcept { //TODO: [C++??] precondition(storage.get(type) is valid);
+			dispatch(indices, type, [&](auto index) { storage.template destroy<decltype(index)::value>(); });
 		}
 
 		template<std::size_t... Indices, typename Storage, typename Comparator>
 		constexpr
-		auto compare(std::index_sequence<Indices...>, std::size_t type, const Storage & lhs, const Storage & rhs, Comparator) noexcept { //TODO: [C++??] precondition(lhs.get(type) is valid && other.get(type) is valid);
-			using Dispatch = bool(*)(const Storage &, const Storage &) noexcept;
-			constexpr Dispatch dispatch[]{+[](const Storage & lhs, const Storage & rhs) noexcept { return Comparator{}(*lhs.template get<Indices>(), *rhs.template get<Indices>()); }...};
-			return dispatch[type](lhs, rhs);
+		auto compare(std::index_sequence<Indices...> indices, std::size_t type, const Storage & lhs, const Storage & rhs, Comparator) noexcept { //TODO: [C++??] precondition(lhs.get(type) is valid && other.get(type) is valid);
+			return dispatch(indices, type, [&](auto index) -> bool { return Comparator{}(*lhs.template get<decltype(index)::value>(), *rhs.template get<decltype(index)::value>()); });
 		}
 
 		template<std::size_t... Indices, typename Storage>
 		constexpr
-		void swap(std::index_sequence<Indices...>, std::size_t type, Storage & lhs, Storage & rhs) noexcept { //TODO: [C++??] precondition(lhs.get(type) is valid && other.get(type) is valid);
-			using Dispatch = void(*)(Storage &, Storage &) noexcept;
-			constexpr Dispatch dispatch[]{+[](Storage & lhs, Storage & rhs) noexcept {
+		void swap(std::index_sequence<Indices...> indices, std::size_t type, Storage & lhs, Storage & rhs) noexcept { //TODO: [C++??] precondition(lhs.get(type) is valid && other.get(type) is valid);
+			dispatch(indices, type, [&](auto index) {
 				using std::swap;
-				swap(*lhs.template get<Indices>(), *rhs.template get<Indices>());
-			}...};
-			dispatch[type](lhs, rhs);
+				swap(*lhs.template get<decltype(index)::value>(), *rhs.template get<decltype(index)::value>());
+			});
 		}
 	}
 
@@ -240,8 +301,8 @@ namespace ptl {
 
 		template<typename T, typename = std::enable_if_t<can_store<T>>> //TODO: [C++20] replace with concepts/requires-clause
 		auto operator=(T && value) -> variant & {
-			variant tmp{std::forward<T>(value)};
-			*this = std::move(tmp);
+			std::decay_t<T> tmp{std::forward<T>(value)}; //value may be stored in this variant
+			emplace<std::decay_t<T>>(std::move(tmp));
 			return *this;
 		}
 
@@ -251,16 +312,17 @@ namespace ptl {
 		auto emplace(Args &&... args) -> decltype(auto) { return emplace<typename decltype(internal_variant::determine_type<Index, Head, Tail...>())::type>(std::forward<Args>(args)...); }
 		template<typename T, typename... Args, typename = std::enable_if_t<can_store<T>>> //TODO: [C++20] replace with concepts/requires-clause
 		auto emplace(Args &&... args) -> T & {
+			constexpr auto index{internal_variant::determine_index<std::decay_t<T>, Head, Tail...>()};
 			if constexpr(std::is_nothrow_constructible_v<T, Args...>) {
 				internal_variant::destroy(indices_t{}, type, storage);
-				constexpr auto index{internal_variant::determine_index<std::decay_t<T>, Head, Tail...>()};
-				internal_variant::emplace(indices_t{}, index, storage, std::forward<Args>(args)...);
-				type = index;
-			} else {
-				variant tmp{std::in_place_type<T>, std::forward<Args>(args)...};
-				*this = std::move(tmp);
+				storage.template set<index>(std::forward<Args>(args)...);
+			} else { //construct the value before destroying the current one, moving it is noexcept
+				T tmp{std::forward<Args>(args)...};
+				internal_variant::destroy(indices_t{}, type, storage);
+				storage.template set<index>(std::move(tmp));
 			}
-			return get<T>();
+			type = index;
+			return *storage.template get<index>();
 		}
 
 		template<typename... Visitors, typename = std::enable_if_t<sizeof...(Visitors) != 0>> //TODO: [C++20] replace with concepts/requires-clause
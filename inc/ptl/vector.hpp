@@ -7,12 +7,26 @@
 #pragma once
 #include <limits>
 #include <memory>
+#include <cstdlib>
+#include <cstring>
 #include <iterator>
 #include <algorithm>
 #include <stdexcept>
 #include <type_traits>
+#include "allocation_policy.hpp"
 
 namespace ptl {
+	//! @brief customization point to mark types as trivially relocatable
+	//! @details a type is trivially relocatable if move constructing an object at a new location and destroying the original is equivalent to copying its bytes
+	//! @note specializations must be derived from std::true_type or std::false_type
+	template<typename Type>
+	struct is_trivially_relocatable : std::is_trivially_copyable<Type> {};
+
+	template<typename Type>
+	inline
+	constexpr
+	bool is_trivially_relocatable_v{is_trivially_relocatable<Type>::value};
+
 	//! @brief a dynamically growing array
 	//! @tparam Type element type of the array
 	template<typename Type>
@@ -33,6 +47,10 @@ namespace ptl {
 		static_assert(min_capacity < max_capacity);
 
 		class storage_t final {
+			//address identifies memory of the global heap that may be passed to realloc, so it must not be replaced by a lambda
+			static
+			void free_memory(Type * ptr) noexcept { std::free(ptr); }
+
 			void(*dealloc)(Type *) noexcept{nullptr};
 
 			Type * ptr{nullptr};
@@ -40,13 +58,18 @@ namespace ptl {
 		public:
 			storage_t() noexcept =default;
 
-			storage_t(std::size_t capacity) {
+			storage_t(std::size_t capacity, allocation_policy * policy = nullptr) {
 				if(capacity == 0) return;
 				if(capacity > max_size()) throw std::length_error{"ptl::vector - allocation attempting to exceed max_size"};
 				capacity = std::max(min_capacity, capacity);
-				dealloc = +[](Type * ptr) noexcept { std::free(ptr); };
-				ptr = static_cast<Type *>(std::calloc(capacity, sizeof(Type)));
-				if(!ptr) throw std::bad_alloc{};
+				if(policy) {
+					ptr = static_cast<Type *>(internal_allocation_policy::allocate(*policy, capacity * sizeof(Type)));
+					dealloc = &internal_allocation_policy::deallocate<Type>;
+				} else {
+					ptr = static_cast<Type *>(std::malloc(capacity * sizeof(Type))); //no need to zero memory as elements are always constructed before use
+					if(!ptr) throw std::bad_alloc{};
+					dealloc = &free_memory;
+				}
 				cap = capacity;
 				siz = 0;
 			}
@@ -79,8 +102,24 @@ namespace ptl {
 			auto size() const noexcept -> std::size_t { return siz; }
 			auto capacity() const noexcept -> std::size_t { return cap; }
 
+			auto policy() const noexcept -> allocation_policy * { return dealloc ? internal_allocation_policy::policy_of(dealloc, ptr) : nullptr; }
+
 			void set_size(std::size_t val) noexcept { siz = val; } //TODO: [C++??] precondition(val <= capacity());
 
+			auto reallocatable() const noexcept -> bool { return dealloc == &free_memory; } //false for memory from a policy, another binary or no memory at all
+
+			//resize memory in place (if possible), only valid for trivially relocatable types
+			//returns false if the memory was left untouched
+			auto reallocate(std::size_t capacity) noexcept -> bool { //TODO: [C++??] precondition(reallocatable());
+				static_assert(is_trivially_relocatable_v<Type>);
+				capacity = std::max(min_capacity, capacity);
+				const auto tmp{std::realloc(static_cast<void *>(ptr), capacity * sizeof(Type))};
+				if(!tmp) return false;
+				ptr = static_cast<Type *>(tmp);
+				cap = capacity;
+				return true;
+			}
+
 			void swap(storage_t & other) noexcept {
 				std::swap(ptr, other.ptr);
 				std::swap(cap, other.cap);
@@ -186,6 +225,30 @@ namespace ptl {
 			pointer ptr{nullptr};
 		};
 
+		//move count elements to uninitialized memory and destroy the originals
+		static
+		void relocate(Type * first, std::size_t count, Type * dst) noexcept {
+			if constexpr(is_trivially_relocatable_v<Type>) {
+				if(count) std::memcpy(static_cast<void *>(dst), first, count * sizeof(Type));
+			} else {
+				std::uninitialized_move_n(first, count, dst);
+				std::destroy_n(first, count);
+			}
+		}
+
+		//exchange storage after all elements have been relocated to tmp
+		void replace_storage(storage_t & tmp, std::size_t size) noexcept {
+			storage.set_size(0);
+			tmp.set_size(size);
+			storage = std::move(tmp);
+		}
+
+		auto grow_capacity(std::size_t required) const -> std::size_t { //geometric growth (factor 2) => amortized O(1) for repeated insertions
+			if(required > max_size()) throw std::length_error{"ptl::vector - allocation attempting to exceed max_size"};
+			const auto cap{capacity()};
+			return std::max(required, cap < max_size() - cap ? cap * 2 : max_size());
+		}
+
 		template<typename Func>
 		void assign_impl(std::size_t required_size, Func func) {
 			if(size() + required_size <= capacity()) { //no need for allocation nor double buffering
@@ -194,7 +257,7 @@ namespace ptl {
 				std::destroy_n(data() + required_size, size());
 				storage.set_size(required_size);
 			} else { //do single allocation
-				storage_t tmp{required_size};
+				storage_t tmp{required_size, storage.policy()};
 				func(tmp.data());
 				tmp.set_size(required_size);
 				storage = std::move(tmp);
@@ -209,28 +272,37 @@ namespace ptl {
 				std::rotate(const_cast<Type *>(pos.ptr), data() + size(), data() + size() + required_size);
 				storage.set_size(size() + required_size);
 			} else { //do single allocation
-				storage_t tmp{size() + std::max(size(), required_size)}; //TODO: evaluate performance of growth influenced by max(size, required_size)
+				storage_t tmp{grow_capacity(size() + required_size), storage.policy()};
 				func(tmp.data() + offset);
-				std::uninitialized_move_n(data(), offset, tmp.data());
-				std::uninitialized_move(data() + offset, data() + size(), tmp.data() + offset + required_size);
-				tmp.set_size(size() + required_size);
-				storage = std::move(tmp);
+				relocate(data(), offset, tmp.data());
+				relocate(data() + offset, size() - offset, tmp.data() + offset + required_size);
+				replace_storage(tmp, size() + required_size);
 			}
 			return begin() + offset;
 		}
 
+		//func must not reference existing elements if may_reallocate is set
 		template<typename Func>
-		void resize_impl(std::size_t new_size, Func func) {
+		void resize_impl(std::size_t new_size, Func func, bool may_reallocate = true) {
 			if(new_size == size()) return;
 			if(new_size < size()) erase(begin() + new_size, end());
-			else {
-				storage_t tmp{new_size};
+			else if(new_size <= capacity() || (may_reallocate && reallocate(grow_capacity(new_size)))) { //no need for (another) allocation
+				func(data() + size(), new_size - size());
+				storage.set_size(new_size);
+			} else {
+				storage_t tmp{grow_capacity(new_size), storage.policy()};
 				func(tmp.data() + size(), new_size - size());
-				std::uninitialized_move_n(data(), size(), tmp.data());
-				tmp.set_size(new_size);
-				storage = std::move(tmp);
+				relocate(data(), size(), tmp.data());
+				replace_storage(tmp, new_size);
 			}
 		}
+
+		auto reallocate(std::size_t new_capacity) noexcept -> bool {
+			if constexpr(is_trivially_relocatable_v<Type>) return storage.reallocatable() && storage.reallocate(new_capacity);
+			else return false;
+		}
+
+		auto is_element(const Type & value) const noexcept -> bool { return std::less_equal<>{}(data(), std::addressof(value)) && std::less<>{}(std::addressof(value), data() + size()); }
 	public:
 		using value_type             = Type;
 		using size_type              = std::size_t;
@@ -264,6 +336,13 @@ namespace ptl {
 
 		vector(std::initializer_list<Type> ilist) : vector(ilist.begin(), ilist.end()) {}
 
+		//! @brief create an empty vector whose memory is provided by a custom policy
+		//! @param[in] policy source of all future allocations of this vector (copies use the global heap)
+		//! @param[in] capacity initial capacity, allocated immediately
+		//! @note the policy is found via the allocated memory, thus objects can be destroyed by binaries built with other compilers
+		explicit
+		vector(allocation_policy & policy, size_type capacity = min_capacity) : storage{std::max(capacity, size_type{1}), &policy} { static_assert(alignof(Type) <= alignof(std::max_align_t)); }
+
 		auto operator=(std::initializer_list<Type> ilist) -> vector & {
 			assign(ilist.begin(), ilist.end());
 			return *this;
@@ -294,11 +373,34 @@ namespace ptl {
 		static
 		auto max_size() noexcept-> size_type { return max_capacity; }
 		auto capacity() const noexcept -> size_type { return storage.capacity(); }
+		//! @returns policy providing the current memory, nullptr for the global heap
+		//! @note memory provided by a policy through another binary is not detected and reported as nullptr
+		auto policy() const noexcept -> allocation_policy * { return storage.policy(); }
 
 		auto push_back(const Type & value) -> reference { return emplace_back(value); }
 		auto push_back(Type && value) -> reference { return emplace_back(std::move(value)); }
 		template<typename... Args>
-		auto emplace_back(Args &&... args) -> reference { return *emplace(end(), std::forward<Args>(args)...); }
+		auto emplace_back(Args &&... args) -> reference {
+			if(size() == capacity()) {
+				if constexpr(is_trivially_relocatable_v<Type>)
+					if(storage.reallocatable()) { //construct new element before growing in place => args may alias elements
+						const auto new_capacity{grow_capacity(size() + 1)};
+						alignas(Type) unsigned char buffer[sizeof(Type)];
+						const auto ptr{new(buffer) Type{std::forward<Args>(args)...}}; //TODO: [C++20] use construct_at
+						if(!storage.reallocate(new_capacity)) {
+							std::destroy_at(ptr);
+							throw std::bad_alloc{};
+						}
+						std::memcpy(static_cast<void *>(data() + size()), buffer, sizeof(Type)); //relocate new element
+						storage.set_size(size() + 1);
+						return back();
+					}
+				return *emplace(end(), std::forward<Args>(args)...); //growth constructs new element before relocating the old ones => args may alias elements
+			}
+			const auto ptr{new(data() + size()) Type{std::forward<Args>(args)...}}; //TODO: [C++20] use construct_at
+			storage.set_size(size() + 1);
+			return *ptr;
+		}
 
 		void pop_back() noexcept { //TODO: [C++??] precondition(!empty());
 			storage.set_size(size() - 1);
@@ -307,22 +409,27 @@ namespace ptl {
 
 		void reserve(size_type new_capacity) {
 			if(new_capacity <= capacity()) return;
-			storage_t tmp{new_capacity};
-			if(!empty()) std::uninitialized_move_n(data(), size(), tmp.data());
-			tmp.set_size(size());
-			storage = std::move(tmp);
+			if(new_capacity > max_size()) throw std::length_error{"ptl::vector - allocation attempting to exceed max_size"};
+			if(reallocate(new_capacity)) return;
+			storage_t tmp{new_capacity, storage.policy()};
+			relocate(data(), size(), tmp.data());
+			replace_storage(tmp, size());
 		}
 
 		void resize(size_type count) { resize_impl(count, [](auto pos, auto count) { std::uninitialized_value_construct_n(pos, count); }); }
-		void resize(size_type count, const Type & value) { resize_impl(count, [&](auto pos, auto count) { std::uninitialized_fill_n(pos, count, value); }); }
+		void resize(size_type count, const Type & value) { resize_impl(count, [&](auto pos, auto count) { std::uninitialized_fill_n(pos, count, value); }, !is_element(value)); }
+		//! @brief resize without value-initializing new elements
+		//! @param[in] count new size of the vector
+		//! @attention new elements are default-initialized, for trivial types their value is indeterminate until written!
+		void resize_for_overwrite(size_type count) { resize_impl(count, [](auto pos, auto count) { std::uninitialized_default_construct_n(pos, count); }); }
 
 		void shrink_to_fit() noexcept {
 			if(size() * 2 >= capacity()) return; //TODO: better criteria for "excess memory usage"
 
-			storage_t tmp{size()};
-			std::uninitialized_move_n(data(), size(), tmp.data());
-			tmp.set_size(size());
-			storage = std::move(tmp);
+			if(!empty() && reallocate(size())) return;
+			storage_t tmp{size(), storage.policy()};
+			relocate(data(), size(), tmp.data());
+			replace_storage(tmp, size());
 		}
 
 		void clear() noexcept {
@@ -395,6 +502,14 @@ namespace ptl {
 	template<typename InputIterator>
 	vector(InputIterator, InputIterator) -> vector<typename std::iterator_traits<InputIterator>::value_type>;
 
+	template<typename Type>
+	struct is_trivially_relocatable<vector<Type>> : std::true_type {};
+
+	class string;
+
+	template<>
+	struct is_trivially_relocatable<string> : std::true_type {};
+
 	//TODO: [C++20] erase
 	//TODO: [C++20] erase_if
 }
@@ -0,0 +1,143 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/allocation_policy.hpp>
+#include <ptl/string.hpp>
+#include <ptl/vector.hpp>
+#include "utils.hpp"
+
+namespace {
+	using ptl::test::counting_policy;
+
+	auto is_aligned(const void * ptr) noexcept -> bool { return reinterpret_cast<std::uintptr_t>(ptr) % alignof(std::max_align_t) == 0; }
+}
+
+TEST_CASE("allocation_policy vector", "[allocation_policy]") {
+	counting_policy counter;
+	{
+		ptl::vector<int> vec{counter.policy};
+		REQUIRE(counter.allocations == 1);
+		REQUIRE(vec.policy() == &counter.policy);
+		REQUIRE(vec.empty());
+		REQUIRE(is_aligned(vec.data()));
+
+		for(int i{0}; i < 1000; ++i) vec.push_back(i);
+		REQUIRE(vec.policy() == &counter.policy); //growth keeps the policy
+		REQUIRE(counter.allocations > 1);
+		REQUIRE(counter.allocations == counter.deallocations + 1);
+
+		vec.resize(5000);
+		vec.shrink_to_fit();
+		vec.reserve(10000);
+		vec.assign(20000, 42);
+		REQUIRE(vec.policy() == &counter.policy);
+		REQUIRE(counter.allocations == counter.deallocations + 1);
+
+		const auto copy{vec}; //copies use the global heap
+		REQUIRE(copy == vec);
+		REQUIRE(copy.policy() == nullptr);
+
+		auto moved{std::move(vec)};
+		REQUIRE(moved.policy() == &counter.policy);
+		REQUIRE(vec.policy() == nullptr);
+
+		ptl::vector<int> other{1, 2, 3};
+		swap(other, moved);
+		REQUIRE(other.policy() == &counter.policy);
+		REQUIRE(moved.policy() == nullptr);
+	}
+	REQUIRE(counter.allocations == counter.deallocations);
+	REQUIRE(counter.bytes == 0);
+
+	ptl::vector<int> vec{counter.policy, 100};
+	REQUIRE(vec.capacity() >= 100);
+	REQUIRE(ptl::vector<int>{}.policy() == nullptr);
+	REQUIRE(ptl::vector<int>{1, 2, 3}.policy() == nullptr);
+}
+
+TEST_CASE("allocation_policy string", "[allocation_policy]") {
+	counting_policy counter;
+	{
+		ptl::string str{counter.policy};
+		REQUIRE(counter.allocations == 1);
+		REQUIRE(str.policy() == &counter.policy);
+		REQUIRE(str.empty());
+		REQUIRE(str.c_str()[0] == 0);
+
+		for(int i{0}; i < 1000; ++i) str.push_back('x');
+		str.append(1000, 'y');
+		str.insert(str.begin(), std::string_view{"prefix"});
+		str.replace(str.begin(), str.begin() + 6, std::string_view{"a much longer prefix exceeding the current capacity"});
+		REQUIRE(str.size() == 2051);
+		REQUIRE(str.policy() == &counter.policy);
+		REQUIRE(counter.allocations == counter.deallocations + 1);
+
+		str = std::string_view{"assigned"};
+		str.assign(5000, 'z');
+		REQUIRE(str.policy() == &counter.policy);
+
+		const auto copy{str};
+		REQUIRE(copy == str);
+		REQUIRE(copy.policy() == nullptr);
+
+		str.clear();
+		str.shrink_to_fit(); //moves back into the object
+		REQUIRE(str.policy() == nullptr);
+	}
+	REQUIRE(counter.allocations == counter.deallocations);
+	REQUIRE(counter.bytes == 0);
+
+	REQUIRE(ptl::string{}.policy() == nullptr);
+	REQUIRE(ptl::string(100, 'x').policy() == nullptr);
+}
+
+TEST_CASE("allocation_policy arena", "[allocation_policy]") {
+	ptl::arena_policy arena{1024};
+	ptl::vector<int> vec{arena};
+	ptl::string str{arena};
+	for(int i{0}; i < 10000; ++i) {
+		vec.push_back(i);
+		str.push_back(static_cast<char>('a' + i % 26));
+	}
+	REQUIRE(vec.policy() == &arena);
+	REQUIRE(str.policy() == &arena);
+	REQUIRE(is_aligned(vec.data()));
+	REQUIRE(is_aligned(str.data()));
+	for(int i{0}; i < 10000; ++i) {
+		REQUIRE(vec[i] == i);
+		REQUIRE(str[i] == static_cast<char>('a' + i % 26));
+	}
+}
+
+TEST_CASE("allocation_policy pool", "[allocation_policy]") {
+	ptl::pool_policy pool{128, 4};
+
+	const char * first;
+	{
+		ptl::string str{pool};
+		first = str.data();
+		REQUIRE(is_aligned(first));
+	}
+	{
+		ptl::string str{pool};
+		REQUIRE(str.data() == first); //released blocks are recycled
+		str.append(1000, 'x'); //exceeds the block size
+		REQUIRE(str.policy() == &pool);
+		REQUIRE(str == std::string(1000, 'x'));
+	}
+
+	ptl::vector<ptl::string> strings;
+	for(int i{0}; i < 100; ++i) {
+		strings.emplace_back(pool);
+		strings.back() = std::string_view{"some text"};
+	}
+	for(const auto & str : strings) {
+		REQUIRE(str.policy() == &pool);
+		REQUIRE(str == "some text");
+	}
+}
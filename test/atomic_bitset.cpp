@@ -0,0 +1,125 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/atomic_bitset.hpp>
+
+TEST_CASE("atomic_bitset ctor", "[atomic_bitset]") {
+	const ptl::atomic_bitset<0> ab0;
+	REQUIRE(ab0.size() == 0);
+	REQUIRE(ab0.word_size() == 0);
+	REQUIRE(ab0.none());
+	REQUIRE(ab0.all());
+
+	const ptl::atomic_bitset<100> ab1;
+	REQUIRE(ab1.size() == 100);
+	REQUIRE(ab1.word_size() == 2);
+	REQUIRE(ab1.count() == 0);
+
+	ptl::bitset<100> bits;
+	bits.set(0).set(63).set(64).set(99);
+	const ptl::atomic_bitset<100> ab2{bits};
+	REQUIRE(ab2.count() == 4);
+	REQUIRE(ab2.load_word(0) == (std::uint64_t{1} | std::uint64_t{1} << 63));
+	REQUIRE(ab2.load_word(1) == (std::uint64_t{1} | std::uint64_t{1} << 35));
+	REQUIRE(ab2.load() == bits);
+
+	static_assert(sizeof(ptl::atomic_bitset<100>) == 16);
+	static_assert(sizeof(ptl::atomic_bitset<128>) == 16);
+	static_assert(sizeof(ptl::atomic_bitset<129>) == 24);
+	const std::uint64_t one{1};
+	if(unsigned char byte; std::memcpy(&byte, &one, 1), byte == 1) //layout matches ptl::bitset on little endian hosts
+		REQUIRE(std::memcmp(&ab2, bits.data(), 13) == 0);
+}
+
+TEST_CASE("atomic_bitset modification", "[atomic_bitset]") {
+	ptl::atomic_bitset<70> ab;
+	REQUIRE_FALSE(ab.test_and_set(3));
+	REQUIRE(ab.test_and_set(3));
+	REQUIRE(ab.test(3));
+	REQUIRE(ab.test_and_reset(3));
+	REQUIRE_FALSE(ab.test_and_reset(3));
+	REQUIRE_FALSE(ab.test(3));
+	REQUIRE_FALSE(ab.test_and_flip(69));
+	REQUIRE(ab.test(69));
+	ab.reset(69);
+	ab.set(68);
+	REQUIRE(ab.test(68));
+	REQUIRE(ab.count() == 1);
+
+	REQUIRE(ab.fetch_or(1, ~std::uint64_t{0}) == std::uint64_t{1} << 4);
+	REQUIRE(ab.load_word(1) == 0b111111); //bits beyond size are ignored
+	REQUIRE(ab.count() == 6);
+	REQUIRE(ab.fetch_and(1, 0b101) == 0b111111);
+	REQUIRE(ab.load_word(1) == 0b101);
+	REQUIRE(ab.fetch_or(0, 0xF0) == 0);
+	REQUIRE(ab.count() == 6);
+	REQUIRE(ab.any());
+	REQUIRE_FALSE(ab.all());
+
+	ptl::bitset<70> all;
+	all.set();
+	ab.store(all);
+	REQUIRE(ab.all());
+	REQUIRE(ab.count() == 70);
+	REQUIRE(ab.load() == all);
+	ab.store(ptl::bitset<70>{});
+	REQUIRE(ab.none());
+}
+
+TEST_CASE("atomic_bitset claim", "[atomic_bitset]") {
+	ptl::atomic_bitset<130> ab;
+	for(std::size_t i{0}; i < 130; ++i) REQUIRE(ab.claim_first_zero() == i);
+	REQUIRE(ab.claim_first_zero() == 130);
+	REQUIRE(ab.all());
+
+	ab.reset(5);
+	ab.reset(100);
+	ab.reset(129);
+	REQUIRE(ab.claim_first_zero(6) == 100);
+	REQUIRE(ab.claim_first_zero(101) == 129);
+	REQUIRE(ab.claim_first_zero(101) == 5); //wraps around
+	REQUIRE(ab.claim_first_zero(130) == 130);
+
+	ab.reset(64);
+	ab.reset(70);
+	REQUIRE(ab.claim_first_zero(65) == 70);
+	REQUIRE(ab.claim_first_zero(65) == 64); //wraps around within the starting word
+
+	ptl::atomic_bitset<0> empty;
+	REQUIRE(empty.claim_first_zero() == 0);
+}
+
+TEST_CASE("atomic_bitset concurrency", "[atomic_bitset]") {
+	constexpr std::size_t threads{8}, slots{1000}, rounds{2000};
+	ptl::atomic_bitset<slots> ab;
+	std::atomic<std::size_t> lost{0}; //released slots that were not claimed (assertions are not thread-safe)
+	std::vector<std::vector<std::size_t>> claimed(threads);
+	std::vector<std::thread> workers;
+	for(std::size_t t{0}; t < threads; ++t)
+		workers.emplace_back([&, t] {
+			for(std::size_t i{0}; i < rounds; ++i) { //claim and release some slots to contend on the same words
+				const auto slot{ab.claim_first_zero(t * slots / threads)};
+				if(slot == slots) continue;
+				if(i % 2) claimed[t].push_back(slot);
+				else if(!ab.test_and_reset(slot)) ++lost;
+			}
+		});
+	for(auto & worker : workers) worker.join();
+	REQUIRE(lost == 0);
+
+	std::vector<std::size_t> all;
+	for(const auto & indices : claimed) all.insert(all.end(), indices.begin(), indices.end());
+	std::sort(all.begin(), all.end());
+	REQUIRE(std::adjacent_find(all.begin(), all.end()) == all.end()); //no slot was handed out twice
+	REQUIRE(ab.count() == all.size());
+	for(const auto slot : all) REQUIRE(ab.test(slot));
+}
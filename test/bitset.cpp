@@ -5,8 +5,12 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #include <bitset>
+#include <random>
+#include <string>
 #include <numeric>
 #include <sstream>
+#include <vector>
+#include <string_view>
 #include <catch2/catch_all.hpp> //TODO: use more specific headers
 #include <ptl/bitset.hpp>
 
@@ -55,6 +59,108 @@ TEST_CASE("bitset io", "[bitset]") {
 	REQUIRE(b4 == b6);
 }
 
+namespace {
+	template<std::size_t Size>
+	void test_conversion() {
+		std::mt19937_64 engine{Size};
+		std::bitset<Size> sb;
+		ptl::bitset<Size> pb;
+		for(std::size_t i{0}; i < Size; ++i)
+			if(engine() % 3 == 0) {
+				sb.set(i);
+				pb.set(i);
+			}
+
+		//binary
+		std::string str(Size + 1, 'x');
+		const auto [end, ec]{pb.to_chars(str.data(), str.data() + str.size())};
+		REQUIRE(ec == std::errc{});
+		REQUIRE(end == str.data() + Size);
+		REQUIRE(str.substr(0, Size) == sb.to_string());
+
+		ptl::bitset<Size> parsed;
+		const auto result{parsed.from_chars(str.data(), str.data() + str.size())};
+		REQUIRE(result.ec == std::errc{});
+		REQUIRE(result.ptr == str.data() + Size);
+		REQUIRE(parsed == pb);
+
+		//hexadecimal
+		std::string hex;
+		for(auto i{(Size + 3) / 4}; i != 0; --i) {
+			auto digit{0};
+			for(std::size_t bit{0}; bit < 4; ++bit)
+				if((i - 1) * 4 + bit < Size && sb[(i - 1) * 4 + bit]) digit |= 1 << bit;
+			hex += "0123456789abcdef"[digit];
+		}
+		str.assign(hex.size(), 'x');
+		REQUIRE(pb.to_chars(str.data(), str.data() + str.size(), 16).ptr == str.data() + str.size());
+		REQUIRE(str == hex);
+		parsed.reset();
+		REQUIRE(parsed.from_chars(hex.data(), hex.data() + hex.size(), 16).ec == std::errc{});
+		REQUIRE(parsed == pb);
+
+		//too small
+		REQUIRE(pb.to_chars(str.data(), str.data() + str.size() - 1, 16).ec == std::errc::value_too_large);
+
+		//streams
+		std::stringstream ss;
+		ss << pb << ' ' << pb;
+		REQUIRE(ss.str() == sb.to_string() + ' ' + sb.to_string());
+		ptl::bitset<Size> streamed;
+		REQUIRE(ss >> streamed);
+		REQUIRE(streamed == pb);
+		streamed.reset();
+		REQUIRE(ss >> streamed);
+		REQUIRE(streamed == pb);
+		REQUIRE_FALSE(ss >> streamed);
+	}
+}
+
+TEST_CASE("bitset conversion", "[bitset]") {
+	test_conversion<1>();
+	test_conversion<7>();
+	test_conversion<8>();
+	test_conversion<13>();
+	test_conversion<64>();
+	test_conversion<65>();
+	test_conversion<200>();
+	test_conversion<65536>();
+
+	ptl::bitset<10> pb{0b11};
+	const std::string_view digits{"101x"};
+	auto result{pb.from_chars(digits.data(), digits.data() + digits.size())};
+	REQUIRE(result.ec == std::errc{});
+	REQUIRE(result.ptr == digits.data() + 3);
+	REQUIRE(pb == ptl::bitset<10>{0b101});
+
+	const std::string_view too_long{"111111111111"};
+	result = pb.from_chars(too_long.data(), too_long.data() + too_long.size());
+	REQUIRE(result.ptr == too_long.data() + 10);
+	REQUIRE(pb == ptl::bitset<10>{0b1111111111});
+
+	const std::string_view hex{"3fFg"};
+	result = pb.from_chars(hex.data(), hex.data() + hex.size(), 16);
+	REQUIRE(result.ec == std::errc{});
+	REQUIRE(result.ptr == hex.data() + 3);
+	REQUIRE(pb == ptl::bitset<10>{0x3ff});
+
+	pb.reset();
+	const std::string_view overflow{"7ff"};
+	result = pb.from_chars(overflow.data(), overflow.data() + overflow.size(), 16);
+	REQUIRE(result.ec == std::errc::result_out_of_range);
+	REQUIRE(result.ptr == overflow.data() + 3);
+	REQUIRE(pb.none());
+
+	result = pb.from_chars(digits.data() + 3, digits.data() + digits.size());
+	REQUIRE(result.ec == std::errc::invalid_argument);
+	REQUIRE(result.ptr == digits.data() + 3);
+	REQUIRE(pb.none());
+
+	std::stringstream ss{"x"};
+	REQUIRE_FALSE(ss >> pb);
+	REQUIRE(pb.none());
+}
+
 TEST_CASE("bitset set", "[bitset]") {
 	std::bitset<10> sb;
 	ptl::bitset<10> pb;
@@ -133,6 +239,73 @@ TEST_CASE("bitset count", "[bitset]") {
 	REQUIRE(!pb.all());
 }
 
+namespace {
+	template<std::size_t Size>
+	void test_searching() {
+		ptl::bitset<Size> pb;
+		REQUIRE(pb.count() == 0);
+		REQUIRE(pb.find_first() == Size);
+		REQUIRE(pb.find_last() == Size);
+		REQUIRE(pb.set_bits().begin() == pb.set_bits().end());
+
+		std::vector<std::size_t> expected;
+		for(std::size_t i{0}; i < Size; i += (i % 5) + 1) {
+			pb.set(i);
+			expected.push_back(i);
+		}
+		REQUIRE(pb.count() == expected.size());
+		REQUIRE(pb.find_first() == expected.front());
+		REQUIRE(pb.find_last() == expected.back());
+		for(std::size_t i{0}; i < expected.size(); ++i) REQUIRE(pb.find_next(expected[i]) == (i + 1 < expected.size() ? expected[i + 1] : Size));
+		REQUIRE(pb.find_next(Size - 1) == Size);
+		REQUIRE(pb.find_next(Size) == Size);
+
+		std::vector<std::size_t> found;
+		for(auto index : pb.set_bits()) found.push_back(index);
+		REQUIRE(found == expected);
+
+		pb.reset();
+		pb.set(Size - 1);
+		REQUIRE(pb.count() == 1);
+		REQUIRE(pb.find_first() == Size - 1);
+		REQUIRE(pb.find_last() == Size - 1);
+		pb.set();
+		REQUIRE(pb.count() == Size);
+		REQUIRE(pb.find_first() == 0);
+		REQUIRE(pb.find_last() == Size - 1);
+		REQUIRE(static_cast<std::size_t>(std::distance(pb.set_bits().begin(), pb.set_bits().end())) == Size);
+	}
+
+	constexpr
+	auto searching_constexpr() noexcept -> bool {
+		ptl::bitset<300> pb;
+		pb.set(3);
+		pb.set(64);
+		pb.set(299);
+		std::size_t sum{0};
+		for(auto index : pb.set_bits()) sum += index;
+		return pb.count() == 3 && pb.find_first() == 3 && pb.find_next(3) == 64 && pb.find_next(64) == 299 && pb.find_last() == 299 && sum == 366;
+	}
+}
+
+TEST_CASE("bitset searching", "[bitset]") {
+	test_searching<1>();
+	test_searching<10>();
+	test_searching<64>();
+	test_searching<65>();
+	test_searching<1000>();
+	test_searching<65536>();
+
+	ptl::bitset<0> empty;
+	REQUIRE(empty.count() == 0);
+	REQUIRE(empty.find_first() == 0);
+	REQUIRE(empty.find_last() == 0);
+	REQUIRE(empty.find_next(0) == 0);
+	REQUIRE(empty.set_bits().begin() == empty.set_bits().end());
+
+	static_assert(searching_constexpr());
+}
+
 TEST_CASE("bitset bitwise", "[bitset]") {
 	ptl::bitset<10> pb1, pb2, expected;
 
@@ -159,6 +332,63 @@ TEST_CASE("bitset bitwise", "[bitset]") {
 	REQUIRE((pb1 ^ pb2) == expected);
 }
 
+namespace {
+	template<std::size_t Size>
+	void test_bulk_operations() {
+		ptl::bitset<Size> pb1, pb2;
+		for(std::size_t i{0}; i < Size; i += 3) pb1.set(i);
+		for(std::size_t i{0}; i < Size; i += 7) pb2.set(i);
+		REQUIRE(pb1 != pb2);
+		REQUIRE(pb1[0]);
+		REQUIRE(!pb1[1]);
+
+		const auto require_bits{[](const ptl::bitset<Size> & pb, auto pred) {
+			for(std::size_t i{0}; i < Size; ++i) REQUIRE(pb[i] == pred(i % 3 == 0, i % 7 == 0));
+		}};
+		require_bits(pb1 & pb2, [](bool lhs, bool rhs) { return lhs && rhs; });
+		require_bits(pb1 | pb2, [](bool lhs, bool rhs) { return lhs || rhs; });
+		require_bits(pb1 ^ pb2, [](bool lhs, bool rhs) { return lhs != rhs; });
+		require_bits(~pb1, [](bool lhs, bool) { return !lhs; });
+		REQUIRE((~pb1).count() == Size - pb1.count());
+		REQUIRE(pb1.any());
+		REQUIRE(!pb1.all());
+		REQUIRE((pb1 | ~pb1).all());
+		REQUIRE((pb1 & ~pb1).none());
+
+		//differences in the last bit must be detected
+		auto pb3{pb1};
+		pb3.flip(Size - 1);
+		REQUIRE(pb3 != pb1);
+		pb3 ^= pb1;
+		REQUIRE(pb3.any());
+		REQUIRE(pb3.count() == 1);
+		pb3.flip();
+		REQUIRE(!pb3.all());
+	}
+
+	constexpr
+	auto bulk_operations_constexpr() noexcept -> bool {
+		ptl::bitset<1000> pb1, pb2;
+		pb1.set(0);
+		pb1.set(999);
+		pb2.set(999);
+		pb2 |= pb1;
+		pb2 &= ~ptl::bitset<1000>{1};
+		pb2 ^= pb1;
+		return pb2.any() && !pb2.all() && pb2 == ptl::bitset<1000>{1} && !(pb2 == pb1);
+	}
+}
+
+TEST_CASE("bitset bulk operations", "[bitset]") {
+	test_bulk_operations<10>();
+	test_bulk_operations<64>();
+	test_bulk_operations<1000>();
+	test_bulk_operations<4096>();
+	test_bulk_operations<4097>();
+
+	static_assert(bulk_operations_constexpr());
+}
+
 TEST_CASE("bitset shifting", "[bitset]") {
 	ptl::bitset<10> pb, expected;
 
@@ -191,6 +421,49 @@ TEST_CASE("bitset shifting", "[bitset]") {
 	REQUIRE(pb == expected);
 }
 
+namespace {
+	template<std::size_t Size>
+	void test_shifting() {
+		const auto pattern{[](std::size_t i) { return i % 3 == 0 || i % 11 == 5; }};
+		ptl::bitset<Size> pb;
+		for(std::size_t i{0}; i < Size; ++i) pb.set(i, pattern(i));
+
+		for(std::size_t count{0}; count <= Size + 1; ++count) {
+			const auto left{pb << count}, right{pb >> count};
+			auto valid{true};
+			for(std::size_t i{0}; i < Size; ++i) {
+				valid = valid && left[i] == (i >= count && pattern(i - count));
+				valid = valid && right[i] == (i + count < Size && pattern(i + count));
+			}
+			REQUIRE(valid);
+		}
+	}
+
+	constexpr
+	auto shifting_constexpr() noexcept -> bool {
+		ptl::bitset<100> pb{1};
+		pb <<= 99;
+		auto expected{ptl::bitset<100>{}.set(99)};
+		if(pb != expected) return false;
+		pb >>= 37;
+		expected >>= 37;
+		return pb == expected && pb == ptl::bitset<100>{}.set(62);
+	}
+}
+
+TEST_CASE("bitset shifting sizes", "[bitset]") {
+	test_shifting<1>();
+	test_shifting<7>();
+	test_shifting<8>();
+	test_shifting<10>();
+	test_shifting<64>();
+	test_shifting<65>();
+	test_shifting<200>();
+	test_shifting<1000>();
+
+	static_assert(shifting_constexpr());
+}
+
 TEST_CASE("bitset swapping", "[bitset]") {
 	const ptl::bitset<10> pb1{0b1010'1010}, pb2{0b0101'0101};
 	auto pb3{pb1}, pb4{pb2};
@@ -0,0 +1,198 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <random>
+#include <vector>
+#include <sstream>
+#include <unordered_set>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/dynamic_bitset.hpp>
+
+namespace {
+	auto equal(const std::vector<bool> & lhs, const ptl::dynamic_bitset & rhs) -> bool {
+		if(lhs.size() != rhs.size()) return false;
+		for(std::size_t i{0}; i < lhs.size(); ++i)
+			if(lhs[i] != rhs[i])
+				return false;
+		return true;
+	}
+
+	auto make_random(std::size_t size, std::mt19937_64 & engine) -> std::pair<std::vector<bool>, ptl::dynamic_bitset> {
+		std::vector<bool> vb(size);
+		ptl::dynamic_bitset db(size);
+		for(std::size_t i{0}; i < size; ++i)
+			if(engine() % 3 == 0) {
+				vb[i] = true;
+				db.set(i);
+			}
+		return {vb, db};
+	}
+}
+
+TEST_CASE("dynamic_bitset ctor", "[dynamic_bitset]") {
+	const ptl::dynamic_bitset db0;
+	REQUIRE(db0.empty());
+	REQUIRE(db0.size() == 0);
+	REQUIRE(db0.capacity() == 0);
+	REQUIRE(db0.none());
+	REQUIRE(db0.all());
+	REQUIRE(db0.count() == 0);
+	REQUIRE(db0.find_first() == 0);
+
+	const ptl::dynamic_bitset db1(13);
+	REQUIRE(db1.size() == 13);
+	REQUIRE(db1.capacity() >= 13);
+	REQUIRE(db1.none());
+
+	const ptl::dynamic_bitset db2(13, true);
+	REQUIRE(db2.all());
+	REQUIRE(db2.count() == 13);
+	REQUIRE(db2.data()[1] == 0b11111);
+
+	auto db3{db2};
+	REQUIRE(db3 == db2);
+	REQUIRE(db3 != db1);
+	db3 = db1;
+	REQUIRE(db3 == db1);
+
+	auto db4{std::move(db3)};
+	REQUIRE(db4 == db1);
+	REQUIRE(db3.empty());
+
+	REQUIRE_THROWS_AS(db1.at(13), std::out_of_range);
+	REQUIRE_THROWS_AS(db4.set(13), std::out_of_range);
+}
+
+TEST_CASE("dynamic_bitset resize", "[dynamic_bitset]") {
+	std::mt19937_64 engine{42};
+	std::vector<bool> vb;
+	ptl::dynamic_bitset db;
+	for(auto i{0}; i < 1000; ++i) {
+		switch(engine() % 4) {
+			case 0: {
+				const auto value{engine() % 2 == 0};
+				vb.push_back(value);
+				db.push_back(value);
+			} break;
+			case 1:
+				if(!vb.empty()) {
+					vb.pop_back();
+					db.pop_back();
+				}
+				break;
+			case 2: {
+				const auto size{static_cast<std::size_t>(engine() % 300)};
+				const auto value{engine() % 2 == 0};
+				vb.resize(size, value);
+				db.resize(size, value);
+			} break;
+			case 3:
+				if(!vb.empty()) {
+					const auto index{static_cast<std::size_t>(engine() % vb.size())};
+					vb[index] = !vb[index];
+					db[index].flip();
+				}
+				break;
+		}
+		REQUIRE(equal(vb, db));
+		REQUIRE(db.count() == static_cast<std::size_t>(std::count(vb.begin(), vb.end(), true)));
+		REQUIRE(db.all() == (std::count(vb.begin(), vb.end(), false) == 0));
+	}
+
+	const auto capacity{db.capacity()};
+	db.clear();
+	REQUIRE(db.empty());
+	REQUIRE(db.capacity() == capacity);
+	db.resize(100);
+	REQUIRE(db.none());
+	db.shrink_to_fit();
+	REQUIRE(db.capacity() < capacity);
+	REQUIRE(db.size() == 100);
+
+	db.reserve(100000);
+	REQUIRE(db.capacity() >= 100000);
+	REQUIRE(db.size() == 100);
+}
+
+TEST_CASE("dynamic_bitset searching", "[dynamic_bitset]") {
+	std::mt19937_64 engine{1};
+	for(const std::size_t size : {1, 7, 8, 63, 64, 65, 200, 4099}) {
+		auto [vb, db]{make_random(size, engine)};
+
+		std::vector<std::size_t> expected;
+		for(std::size_t i{0}; i < size; ++i)
+			if(vb[i])
+				expected.push_back(i);
+		REQUIRE(std::vector<std::size_t>(db.set_bits().begin(), db.set_bits().end()) == expected);
+		REQUIRE(db.count() == expected.size());
+		REQUIRE(db.find_first() == (expected.empty() ? size : expected.front()));
+		REQUIRE(db.find_last() == (expected.empty() ? size : expected.back()));
+		for(std::size_t i{0}; i < expected.size(); ++i) REQUIRE(db.find_next(expected[i]) == (i + 1 < expected.size() ? expected[i + 1] : size));
+
+		db.reset();
+		REQUIRE(db.none());
+		REQUIRE(db.set_bits().begin() == db.set_bits().end());
+		db.set();
+		REQUIRE(db.all());
+		REQUIRE(db.count() == size);
+		REQUIRE(static_cast<std::size_t>(std::distance(db.set_bits().begin(), db.set_bits().end())) == size);
+	}
+}
+
+TEST_CASE("dynamic_bitset bitwise", "[dynamic_bitset]") {
+	std::mt19937_64 engine{2};
+	for(const std::size_t size : {1, 13, 64, 100, 1000}) {
+		const auto [vb1, db1]{make_random(size, engine)};
+		const auto [vb2, db2]{make_random(size, engine)};
+
+		auto combine{[&](auto op) {
+			std::vector<bool> result(size);
+			for(std::size_t i{0}; i < size; ++i) result[i] = op(vb1[i], vb2[i]);
+			return result;
+		}};
+		REQUIRE(equal(combine([](bool lhs, bool rhs) { return lhs && rhs; }), db1 & db2));
+		REQUIRE(equal(combine([](bool lhs, bool rhs) { return lhs || rhs; }), db1 | db2));
+		REQUIRE(equal(combine([](bool lhs, bool rhs) { return lhs != rhs; }), db1 ^ db2));
+		REQUIRE(equal(combine([](bool lhs, bool) { return !lhs; }), ~db1));
+		REQUIRE((~db1).count() == size - db1.count());
+
+		for(const std::size_t count : {std::size_t{0}, std::size_t{1}, std::size_t{9}, size / 2, size - 1, size, size + 1}) {
+			std::vector<bool> left(size), right(size);
+			for(std::size_t i{0}; i < size; ++i) {
+				if(i >= count) left[i] = vb1[i - count];
+				if(i + count < size) right[i] = vb1[i + count];
+			}
+			REQUIRE(equal(left, db1 << count));
+			REQUIRE(equal(right, db1 >> count));
+			REQUIRE((db1 << count).count() == static_cast<std::size_t>(std::count(left.begin(), left.end(), true)));
+		}
+	}
+}
+
+TEST_CASE("dynamic_bitset io", "[dynamic_bitset]") {
+	ptl::dynamic_bitset db(10);
+	db.set(1).set(9);
+
+	std::stringstream ss;
+	ss << db;
+	REQUIRE(ss.str() == "1000000010");
+
+	char hex[3];
+	REQUIRE(db.to_chars(hex, hex + sizeof(hex), 16).ec == std::errc{});
+	REQUIRE(std::string_view{hex, sizeof(hex)} == "202");
+	REQUIRE(db.to_chars(hex, hex + 2, 16).ec == std::errc::value_too_large);
+}
+
+TEST_CASE("dynamic_bitset hash", "[dynamic_bitset]") {
+	std::unordered_set<ptl::dynamic_bitset> set;
+	ptl::dynamic_bitset db(100);
+	for(std::size_t i{0}; i < db.size(); ++i) {
+		db.set(i);
+		set.insert(db);
+	}
+	REQUIRE(set.size() == 100);
+	REQUIRE(set.count(ptl::dynamic_bitset(100, true)) == 1);
+}
@@ -0,0 +1,70 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <set>
+#include <vector>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/hash.hpp>
+#include <ptl/bitset.hpp>
+#include <ptl/string.hpp>
+#include <ptl/string_ref.hpp>
+
+TEST_CASE("hash reference values", "[hash]") {
+	//reference values of wyhash (final version 4), seeded with their index
+	const std::string_view messages[]{
+		"",
+		"a",
+		"abc",
+		"message digest",
+		"abcdefghijklmnopqrstuvwxyz",
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+	};
+	const std::uint64_t expected[]{
+		0x93228a4de0eec5a2,
+		0xc5bac3db178713c4,
+		0xa97f2f7b1d9b3314,
+		0x786d1f1df3801df4,
+		0xdca5a8138ad37c87,
+		0xb9e734f117cfaf70,
+	};
+	for(std::size_t i{0}; i < std::size(messages); ++i) REQUIRE(ptl::hash_bytes(messages[i].data(), messages[i].size(), i) == expected[i]);
+}
+
+TEST_CASE("hash lengths", "[hash]") {
+	std::vector<unsigned char> bytes(256);
+	for(std::size_t i{0}; i < bytes.size(); ++i) bytes[i] = static_cast<unsigned char>(i * 37 + 11);
+
+	std::set<std::uint64_t> hashes;
+	for(std::size_t size{0}; size <= bytes.size(); ++size) { //covers every code path
+		const auto hash{ptl::hash_bytes(bytes.data(), size)};
+		REQUIRE(hashes.insert(hash).second);
+		REQUIRE(ptl::hash_bytes(bytes.data(), size) == hash);
+		REQUIRE(ptl::hash_bytes(bytes.data(), size, 1) != hash);
+		if(size == 0) continue;
+		auto copy{bytes};
+		copy[size - 1] ^= 1; //every byte contributes
+		REQUIRE(ptl::hash_bytes(copy.data(), size) != hash);
+		copy = bytes;
+		copy[0] ^= 128;
+		REQUIRE(ptl::hash_bytes(copy.data(), size) != hash);
+	}
+}
+
+TEST_CASE("hash specializations", "[hash]") {
+	using namespace ptl::literals;
+
+	REQUIRE(std::hash<ptl::string>{}("hello world"_s) == static_cast<std::size_t>(ptl::hash_bytes("hello world", 11)));
+	REQUIRE(std::hash<ptl::string>{}("hello world"_s) == std::hash<ptl::string_ref>{}("hello world"_sr));
+	REQUIRE(std::hash<ptl::string>{}(ptl::string{}) == std::hash<ptl::string_ref>{}(ptl::string_ref{}));
+
+	ptl::bitset<20> pb;
+	pb.set(0);
+	pb.set(9);
+	pb.set(19);
+	const unsigned char bytes[]{0b0000'0001, 0b0000'0010, 0b0000'1000};
+	REQUIRE(std::hash<ptl::bitset<20>>{}(pb) == static_cast<std::size_t>(ptl::hash_bytes(bytes, sizeof(bytes))));
+	REQUIRE(std::hash<ptl::bitset<20>>{}(pb) != std::hash<ptl::bitset<20>>{}(ptl::bitset<20>{}));
+}
@@ -0,0 +1,85 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <random>
+#include <vector>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/rank_select.hpp>
+
+namespace {
+	void check(const ptl::dynamic_bitset & bits) {
+		const ptl::rank_select index{bits};
+		REQUIRE(index.size() == bits.size());
+		REQUIRE(index.count() == bits.count());
+
+		std::size_t rank{0};
+		for(std::size_t i{0}; i < bits.size(); ++i) {
+			REQUIRE(index.rank(i) == rank);
+			if(bits[i]) {
+				REQUIRE(index.select(rank) == i);
+				++rank;
+			}
+		}
+		REQUIRE(index.rank(bits.size()) == rank);
+		REQUIRE(index.select(rank) == bits.size());
+		REQUIRE(index.select(rank + 1000) == bits.size());
+	}
+}
+
+TEST_CASE("rank_select empty", "[rank_select]") {
+	const ptl::rank_select index;
+	REQUIRE(index.size() == 0);
+	REQUIRE(index.count() == 0);
+	REQUIRE(index.rank(0) == 0);
+	REQUIRE(index.select(0) == 0);
+
+	check(ptl::dynamic_bitset{});
+	check(ptl::dynamic_bitset(100000));
+}
+
+TEST_CASE("rank_select densities", "[rank_select]") {
+	std::mt19937_64 engine{42};
+	for(const std::size_t size : {1, 63, 64, 65, 511, 512, 513, 4095, 4096, 4097, 100000})
+		for(const std::uint64_t density : {1, 2, 16, 1000}) {
+			ptl::dynamic_bitset bits(size);
+			for(std::size_t i{0}; i < size; ++i)
+				if(engine() % density == 0)
+					bits.set(i);
+			check(bits);
+		}
+
+	//clusters separated by long empty runs stress the search between samples
+	ptl::dynamic_bitset clustered(300000);
+	for(std::size_t i{0}; i < 20000; ++i) clustered.set(i);
+	for(std::size_t i{250000}; i < 270000; i += 3) clustered.set(i);
+	clustered.set(299999);
+	check(clustered);
+}
+
+TEST_CASE("rank_select bitset", "[rank_select]") {
+	ptl::bitset<1000> bits;
+	for(std::size_t i{0}; i < bits.size(); i += 7) bits.set(i);
+	const ptl::rank_select index{bits};
+	REQUIRE(index.count() == 143);
+	REQUIRE(index.rank(0) == 0);
+	REQUIRE(index.rank(1) == 1);
+	REQUIRE(index.rank(700) == 100);
+	REQUIRE(index.rank(701) == 101);
+	REQUIRE(index.select(100) == 700);
+	REQUIRE(index.select(142) == 994);
+	REQUIRE(index.select(143) == 1000);
+
+	const ptl::rank_select none{ptl::bitset<0>{}};
+	REQUIRE(none.count() == 0);
+}
+
+TEST_CASE("rank_select overhead", "[rank_select]") {
+	ptl::dynamic_bitset bits(1 << 20, true);
+	const ptl::rank_select index{bits};
+	REQUIRE(index.memory_usage() * 8 < bits.size() * 6 / 100); //a fully set bitset requires the most samples
+	REQUIRE(index.select(12345) == 12345);
+	REQUIRE(index.rank(12345) == 12345);
+}
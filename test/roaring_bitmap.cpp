@@ -0,0 +1,234 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <set>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/roaring_bitmap.hpp>
+
+namespace {
+	auto random(std::mt19937 & engine, std::uint32_t bound) -> std::uint32_t { return static_cast<std::uint32_t>(engine() % bound); }
+
+	auto values(const ptl::roaring_bitmap & rb) -> std::vector<std::uint32_t> { return {rb.begin(), rb.end()}; }
+
+	//mixes sparse chunks (arrays), dense chunks (bitmaps) and consecutive ranges (runs)
+	auto make_random(std::mt19937 & engine) -> std::set<std::uint32_t> {
+		std::set<std::uint32_t> result;
+		for(std::uint32_t chunk{0}; chunk < 8; ++chunk) {
+			const auto base{chunk * 65536 + random(engine, 4) * 65536};
+			switch(random(engine, 4)) {
+				case 0:
+					for(auto i{0}; i < 100; ++i) result.insert(base + random(engine, 65536));
+					break;
+				case 1:
+					for(auto i{0}; i < 20000; ++i) result.insert(base + random(engine, 65536));
+					break;
+				case 2:
+					for(auto i{0}; i < 10; ++i) {
+						const auto first{base + random(engine, 60000)};
+						for(auto value{first}, last{first + random(engine, 5000)}; value <= last; ++value) result.insert(value);
+					}
+					break;
+				case 3: //overlapping arrays
+					for(auto i{0}; i < 2000; ++i) result.insert(chunk * 65536 + random(engine, 8000));
+					break;
+			}
+		}
+		result.insert(0xFFFFFFFF);
+		return result;
+	}
+
+	auto make_bitmap(const std::set<std::uint32_t> & set) -> ptl::roaring_bitmap {
+		ptl::roaring_bitmap result;
+		for(const auto value : set) result.add(value);
+		return result;
+	}
+}
+
+TEST_CASE("roaring_bitmap modification", "[roaring_bitmap]") {
+	ptl::roaring_bitmap rb;
+	REQUIRE(rb.empty());
+	REQUIRE(rb.cardinality() == 0);
+	REQUIRE(rb.begin() == rb.end());
+
+	REQUIRE(rb.add(7));
+	REQUIRE_FALSE(rb.add(7));
+	REQUIRE(rb.add(0xFFFFFFFF));
+	REQUIRE(rb.add(70000));
+	REQUIRE(values(rb) == std::vector<std::uint32_t>{7, 70000, 0xFFFFFFFF});
+	REQUIRE(rb.contains(70000));
+	REQUIRE_FALSE(rb.contains(70001));
+	REQUIRE(rb.remove(70000));
+	REQUIRE_FALSE(rb.remove(70000));
+	REQUIRE(rb.cardinality() == 2);
+
+	const ptl::roaring_bitmap il{3, 1, 2, 1};
+	REQUIRE(values(il) == std::vector<std::uint32_t>{1, 2, 3});
+
+	std::mt19937 engine{42};
+	std::set<std::uint32_t> set;
+	rb.clear();
+	for(auto i{0}; i < 50000; ++i) { //crosses the array/bitmap threshold in both directions
+		const auto value{random(engine, 12000)};
+		if(random(engine, 3)) REQUIRE(rb.add(value) == set.insert(value).second);
+		else REQUIRE(rb.remove(value) == (set.erase(value) != 0));
+		REQUIRE(rb.cardinality() == set.size());
+	}
+	REQUIRE(values(rb) == std::vector<std::uint32_t>(set.begin(), set.end()));
+
+	rb.clear();
+	set.clear();
+	rb.add_range(100, 200000);
+	for(std::uint32_t value{100}; value <= 200000; ++value) set.insert(value);
+	for(auto i{0}; i < 5000; ++i) { //splits, shrinks and merges runs
+		const auto value{random(engine, 200100)};
+		if(random(engine, 2)) REQUIRE(rb.add(value) == set.insert(value).second);
+		else REQUIRE(rb.remove(value) == (set.erase(value) != 0));
+	}
+	REQUIRE(rb.cardinality() == set.size());
+	REQUIRE(values(rb) == std::vector<std::uint32_t>(set.begin(), set.end()));
+
+	const auto memory{rb.memory_usage()};
+	rb.optimize();
+	REQUIRE(rb.memory_usage() <= memory);
+	REQUIRE(values(rb) == std::vector<std::uint32_t>(set.begin(), set.end()));
+
+	ptl::roaring_bitmap full;
+	full.add_range(0, 0xFFFFFFFF);
+	REQUIRE(full.cardinality() == std::uint64_t{1} << 32);
+	REQUIRE(full.memory_usage() < 65536 * 64);
+	REQUIRE(full.remove(12345));
+	REQUIRE_FALSE(full.contains(12345));
+	REQUIRE(full.cardinality() == (std::uint64_t{1} << 32) - 1);
+}
+
+TEST_CASE("roaring_bitmap set operations", "[roaring_bitmap]") {
+	std::mt19937 engine{1};
+	for(auto i{0}; i < 10; ++i) {
+		const auto lhs{make_random(engine)}, rhs{make_random(engine)};
+		auto rb_lhs{make_bitmap(lhs)}, rb_rhs{make_bitmap(rhs)};
+		if(i % 3 != 0) rb_lhs.optimize(); //ranges become runs
+		if(i % 3 == 2) rb_rhs.optimize();
+		REQUIRE(rb_lhs.cardinality() == lhs.size());
+
+		const auto combine{[&](auto op) {
+			std::vector<std::uint32_t> result;
+			op(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+			return result;
+		}};
+		const auto intersection{combine([](auto... args) { std::set_intersection(args...); })};
+		const auto union_{combine([](auto... args) { std::set_union(args...); })};
+		const auto difference{combine([](auto... args) { std::set_difference(args...); })};
+
+		REQUIRE(values(rb_lhs & rb_rhs) == intersection);
+		REQUIRE((rb_lhs & rb_rhs).cardinality() == intersection.size());
+		REQUIRE(values(rb_lhs | rb_rhs) == union_);
+		REQUIRE((rb_lhs | rb_rhs).cardinality() == union_.size());
+		REQUIRE(values(rb_lhs - rb_rhs) == difference);
+		REQUIRE((rb_lhs - rb_rhs).cardinality() == difference.size());
+
+		auto rb{rb_lhs};
+		rb |= rb_rhs;
+		rb -= rb_lhs;
+		rb &= rb_rhs;
+		REQUIRE(rb == rb_rhs - rb_lhs);
+		REQUIRE(rb != rb_lhs);
+		REQUIRE((rb_lhs - rb_lhs).empty());
+	}
+
+	ptl::roaring_bitmap runs, array; //too many runs to sweep them with an array in the same chunk
+	for(std::uint32_t r{0}; r < 2000; ++r) runs.add_range(r * 32, r * 32 + 2);
+	runs.optimize();
+	std::vector<std::uint32_t> expected;
+	for(std::uint32_t v{0}; v < 200; ++v) {
+		array.add(v * 97);
+		if(v * 97 % 32 <= 2) expected.push_back(v * 97);
+	}
+	REQUIRE(values(runs & array) == expected);
+	REQUIRE(values(array & runs) == expected);
+	REQUIRE((runs - array).cardinality() == runs.cardinality() - expected.size());
+	REQUIRE((runs | array).cardinality() == runs.cardinality() + array.cardinality() - expected.size());
+}
+
+TEST_CASE("roaring_bitmap serialization", "[roaring_bitmap]") {
+	std::mt19937 engine{2};
+	const auto lhs{make_random(engine)}, rhs{make_random(engine)};
+	const auto rb_lhs{make_bitmap(lhs)}, rb_rhs{make_bitmap(rhs)};
+
+	const auto bytes{rb_lhs.serialize()};
+	REQUIRE(bytes.size() == rb_lhs.serialized_size());
+	REQUIRE(std::equal(bytes.begin(), bytes.begin() + 4, "PTLR"));
+
+	std::vector<unsigned char> unaligned(bytes.size() + 1);
+	std::copy(bytes.begin(), bytes.end(), unaligned.begin() + 1);
+	const ptl::roaring_view view{unaligned.data() + 1, bytes.size()};
+	REQUIRE(view.cardinality() == lhs.size());
+	for(auto i{0}; i < 10000; ++i) {
+		const auto value{random(engine, 12 * 65536)};
+		REQUIRE(view.contains(value) == (lhs.count(value) != 0));
+	}
+	REQUIRE(view.contains(0xFFFFFFFF));
+	REQUIRE(ptl::roaring_bitmap{view} == rb_lhs);
+
+	const auto other_bytes{rb_rhs.serialize()};
+	const ptl::roaring_view other{other_bytes.data(), other_bytes.size()};
+	REQUIRE((view & other) == (rb_lhs & rb_rhs));
+	REQUIRE((view | rb_rhs) == (rb_lhs | rb_rhs));
+	REQUIRE((rb_lhs - other) == (rb_lhs - rb_rhs));
+
+	const auto empty{ptl::roaring_bitmap{}.serialize()};
+	REQUIRE(empty.size() == 8);
+	REQUIRE(ptl::roaring_view{empty.data(), empty.size()}.empty());
+
+	REQUIRE_THROWS_AS(ptl::roaring_view(bytes.data(), 7), std::invalid_argument);
+	REQUIRE_THROWS_AS(ptl::roaring_view(bytes.data(), bytes.size() - 1), std::invalid_argument);
+	auto corrupted{bytes};
+	corrupted[0] = 'X';
+	REQUIRE_THROWS_AS(ptl::roaring_view(corrupted.data(), corrupted.size()), std::invalid_argument);
+	corrupted = bytes;
+	corrupted[8 + 2] = 3; //kind of the first container
+	REQUIRE_THROWS_AS(ptl::roaring_view(corrupted.data(), corrupted.size()), std::invalid_argument);
+
+	ptl::roaring_bitmap runs;
+	runs.add_range(10, 20);
+	auto run_bytes{runs.serialize()};
+	run_bytes[8 + 16 + 2] = 0xFF; //length of the run exceeds the chunk
+	run_bytes[8 + 16 + 3] = 0xFF;
+	REQUIRE_THROWS_AS(ptl::roaring_view(run_bytes.data(), run_bytes.size()), std::invalid_argument);
+	run_bytes = runs.serialize();
+	run_bytes[8 + 4] = 5; //cardinality does not match the length of the run
+	REQUIRE_THROWS_AS(ptl::roaring_view(run_bytes.data(), run_bytes.size()), std::invalid_argument);
+
+	runs.add_range(30, 40);
+	const auto two_runs{runs.serialize()};
+	REQUIRE(two_runs[8 + 2] == 2); //kind of the first container
+	REQUIRE(ptl::roaring_view(two_runs.data(), two_runs.size()).cardinality() == 22);
+	for(const auto first : {5, 15, 21}) { //second run is unsorted, overlapping or touching the first
+		run_bytes = two_runs;
+		run_bytes[8 + 16 + 4] = static_cast<unsigned char>(first);
+		run_bytes[8 + 16 + 6] = static_cast<unsigned char>(40 - first);
+		REQUIRE_THROWS_AS(ptl::roaring_view(run_bytes.data(), run_bytes.size()), std::invalid_argument);
+	}
+
+	ptl::roaring_bitmap bitmap;
+	for(std::uint32_t i{0}; i < 10000; ++i) bitmap.add(i * 3);
+	auto bitmap_bytes{bitmap.serialize()};
+	REQUIRE(bitmap_bytes[8 + 2] == 1); //kind of the first container
+	bitmap_bytes[8 + 4] = 5; //cardinality does not match the bits
+	bitmap_bytes[8 + 5] = 0;
+	REQUIRE_THROWS_AS(ptl::roaring_view(bitmap_bytes.data(), bitmap_bytes.size()), std::invalid_argument);
+
+	ptl::roaring_bitmap array;
+	for(const std::uint32_t value : {1, 2, 3}) array.add(value);
+	auto array_bytes{array.serialize()};
+	array_bytes[8 + 16 + 2] = 1; //second value equals the first
+	REQUIRE_THROWS_AS(ptl::roaring_view(array_bytes.data(), array_bytes.size()), std::invalid_argument);
+	array_bytes[8 + 16 + 2] = 0; //values are not increasing
+	REQUIRE_THROWS_AS(ptl::roaring_view(array_bytes.data(), array_bytes.size()), std::invalid_argument);
+}
@@ -0,0 +1,105 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <cstring>
+#include <sstream>
+#include <unordered_set>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/allocation_policy.hpp>
+#include <ptl/shared_string.hpp>
+
+TEST_CASE("shared_string ctor", "[shared_string]") {
+	const ptl::shared_string empty;
+	REQUIRE(empty.empty());
+	REQUIRE(empty.c_str()[0] == 0);
+	REQUIRE(empty.use_count() == 0);
+	REQUIRE(empty == "");
+	const unsigned char zeros[sizeof(ptl::shared_string)]{};
+	REQUIRE(std::memcmp(&empty, zeros, sizeof(zeros)) == 0); //no pointer into the binary that created it
+	REQUIRE(ptl::shared_string{std::string_view{}}.use_count() == 0);
+
+	const ptl::shared_string str{std::string_view{"Hello World"}};
+	REQUIRE(str == "Hello World");
+	REQUIRE(str.size() == 11);
+	REQUIRE(str.c_str()[11] == 0);
+	REQUIRE(str.use_count() == 1);
+	REQUIRE(str.at(4) == 'o');
+	REQUIRE_THROWS_AS(str.at(11), std::out_of_range);
+
+	std::stringstream ss;
+	ss << str;
+	REQUIRE(ss.str() == "Hello World");
+}
+
+TEST_CASE("shared_string from string", "[shared_string]") {
+	ptl::string heap(1'000, 'x');
+	const auto data{heap.data()};
+	const ptl::shared_string adopted{std::move(heap)};
+	REQUIRE(adopted.data() == data); //characters are not copied
+	REQUIRE(adopted == std::string(1'000, 'x'));
+	REQUIRE(adopted.c_str()[1'000] == 0);
+	REQUIRE(heap.empty());
+
+	ptl::string sso{"short"};
+	const ptl::shared_string copied{std::move(sso)};
+	REQUIRE(copied == "short");
+	REQUIRE(copied.use_count() == 1);
+
+	ptl::arena_policy arena;
+	ptl::string from_policy{arena};
+	from_policy.append(100, 'y');
+	const ptl::shared_string shared{std::move(from_policy)};
+	REQUIRE(shared == std::string(100, 'y'));
+}
+
+TEST_CASE("shared_string copy", "[shared_string]") {
+	ptl::shared_string str{ptl::string(100, 'z')};
+	{
+		const auto copy{str};
+		REQUIRE(copy.data() == str.data());
+		REQUIRE(str.use_count() == 2);
+
+		ptl::shared_string assigned;
+		assigned = copy;
+		REQUIRE(str.use_count() == 3);
+		assigned = assigned;
+		REQUIRE(str.use_count() == 3);
+	}
+	REQUIRE(str.use_count() == 1);
+
+	auto moved{std::move(str)};
+	REQUIRE(moved.use_count() == 1);
+	REQUIRE(str.empty());
+	REQUIRE(str.use_count() == 0);
+	REQUIRE(str.c_str()[0] == 0);
+
+	ptl::shared_string other{std::string_view{"other"}};
+	swap(moved, other);
+	REQUIRE(moved == "other");
+	REQUIRE(other == std::string(100, 'z'));
+	other = std::move(moved);
+	REQUIRE(other == "other");
+}
+
+TEST_CASE("shared_string conversion", "[shared_string]") {
+	const ptl::shared_string str{std::string_view{"key=value"}};
+	const ptl::string_ref ref{str};
+	REQUIRE(ref.data() == str.data());
+	REQUIRE(ref.find('=') == 3);
+	const std::string_view sv{str};
+	REQUIRE(sv.data() == str.data());
+	REQUIRE(std::string(str.begin(), str.end()) == "key=value");
+	REQUIRE(std::string(str.rbegin(), str.rend()) == "eulav=yek");
+
+	REQUIRE(str < ptl::shared_string{std::string_view{"key=z"}});
+	REQUIRE(str != ptl::shared_string{});
+	REQUIRE("key=value" == str);
+
+	std::unordered_set<ptl::shared_string> set;
+	set.insert(str);
+	REQUIRE(set.count(ptl::shared_string{std::string_view{"key=value"}}) == 1);
+}
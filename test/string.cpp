@@ -4,7 +4,14 @@
 //    (See accompanying file ../LICENSE_1_0.txt or copy at
 //          http://www.boost.org/LICENSE_1_0.txt)
 
+#include <cmath>
+#include <limits>
 #include <cstring>
+#include <list>
+#include <string>
+#include <random>
+#include <vector>
+#include <charconv>
 #include <sstream>
 #include <catch2/catch_all.hpp> //TODO: use more specific headers
 #include <ptl/string.hpp>
@@ -142,6 +149,39 @@ TEST_CASE("string shrinking", "[string]") {
 	REQUIRE(s0.capacity() == s0.size());
 }
 
+TEST_CASE("string growth", "[string]") {
+	const auto count_reallocations{[](auto append, std::size_t count = 1'000'000) {
+		ptl::string s;
+		std::size_t reallocations{0};
+		auto capacity{s.capacity()};
+		for(std::size_t i{0}; i < count; ++i) {
+			append(s);
+			if(s.capacity() != capacity) {
+				++reallocations;
+				capacity = s.capacity();
+			}
+		}
+		REQUIRE(s.size() >= count);
+		return reallocations;
+	}};
+
+	//geometric growth => logarithmic number of reallocations
+	REQUIRE(count_reallocations([](auto & s) { s.push_back('x'); }) < 40);
+	REQUIRE(count_reallocations([](auto & s) { s.append("xy"); }) < 40);
+	REQUIRE(count_reallocations([](auto & s) { s.append(2, 'x'); }) < 40);
+	REQUIRE(count_reallocations([](auto & s) { s.insert(s.cbegin(), 'x'); }, 10'000) < 20);
+	REQUIRE(count_reallocations([](auto & s) { s.resize(s.size() + 1, 'x'); }) < 40);
+
+	//explicit reservation is not subject to geometric growth
+	ptl::string s;
+	s.reserve(1'000);
+	const auto capacity{s.capacity()};
+	REQUIRE(capacity >= 1'000);
+	REQUIRE(capacity < 1'500);
+	s.resize(capacity);
+	REQUIRE(s.capacity() == capacity);
+}
+
 TEST_CASE("string io", "[string]") {
 	const ptl::string s0{"Hello world"};
 
@@ -362,6 +402,54 @@ TEST_CASE("string replace", "[string]") {
 	REQUIRE(s8 == "X X X");
 }
 
+TEST_CASE("string aliasing", "[string]") {
+	const std::string text{"0123456789abcdefghijklmnopqrstuvwxyz"}; //exceeds SSO
+	for(const std::size_t reserved : {std::size_t{0}, std::size_t{256}}) //with and without reallocation
+		for(std::size_t offset{0}; offset <= text.size(); offset += 3)
+			for(std::size_t count{0}; offset + count <= text.size(); count += 5)
+				for(std::size_t src{0}; src <= text.size(); src += 4)
+					for(std::size_t size{0}; src + size <= text.size(); size += 7) {
+						auto expected{text};
+						expected.replace(offset, count, text.substr(src, size));
+
+						ptl::string replaced{std::string_view{text}};
+						replaced.reserve(reserved);
+						replaced.replace(replaced.cbegin() + offset, replaced.cbegin() + offset + count, std::string_view{replaced}.substr(src, size));
+						REQUIRE(replaced == expected);
+
+						ptl::string reversed{std::string_view{text}}; //non-contiguous iterators referencing the string itself
+						reversed.reserve(reserved);
+						reversed.replace(reversed.cbegin() + offset, reversed.cbegin() + offset + count, reversed.crend() - src - size, reversed.crend() - src);
+						auto expected_reversed{text.substr(src, size)};
+						std::reverse(expected_reversed.begin(), expected_reversed.end());
+						REQUIRE(reversed == std::string{text}.replace(offset, count, expected_reversed));
+
+						if(count == 0) {
+							ptl::string inserted{std::string_view{text}};
+							inserted.reserve(reserved);
+							inserted.insert(inserted.cbegin() + offset, inserted.cbegin() + src, inserted.cbegin() + src + size);
+							REQUIRE(inserted == expected);
+						}
+						if(offset == 0 && count == text.size()) {
+							ptl::string assigned{std::string_view{text}};
+							assigned.reserve(reserved);
+							assigned.assign(std::string_view{assigned}.substr(src, size));
+							REQUIRE(assigned == text.substr(src, size));
+						}
+					}
+
+	const std::list<char> list{'l', 'i', 's', 't'};
+	ptl::string str{"short"};
+	str.replace(str.cbegin() + 1, str.cbegin() + 4, list.begin(), list.end());
+	REQUIRE(str == "slistt");
+	str.insert(str.cbegin(), list.begin(), list.end());
+	REQUIRE(str == "listslistt");
+	str.assign(list.begin(), list.end());
+	REQUIRE(str == "list");
+	str.assign(std::string_view{});
+	REQUIRE(str.empty());
+}
+
 TEST_CASE("string substr", "[string]") {
 	const ptl::string str{"Hello World"};
 
@@ -375,3 +463,135 @@ TEST_CASE("string substr", "[string]") {
 	REQUIRE(str.substr(4, 2) == "o ");
 	REQUIRE("Hello World"_s.substr(4, 2) == "o ");
 }
+
+TEST_CASE("string searching", "[string]") {
+	const ptl::string str{"GET /index.html HTTP/1.1\r\nHost: example.com\r\n\r\n"};
+
+	REQUIRE(str.find("\r\n") == 24);
+	REQUIRE(str.find("\r\n", 25) == 43);
+	REQUIRE(str.rfind("\r\n\r\n") == 43);
+	REQUIRE(str.find(' ') == 3);
+	REQUIRE(str.rfind(' ') == 31);
+	REQUIRE(str.find_first_of(":\r") == 24);
+	REQUIRE(str.find_last_of(':') == 30);
+	REQUIRE(str.find_first_not_of("GET ") == 4);
+	REQUIRE(str.find_last_not_of("\r\n") == 42);
+	REQUIRE(str.find("missing") == ptl::string::npos);
+
+	REQUIRE(str.starts_with("GET "));
+	REQUIRE(str.starts_with('G'));
+	REQUIRE(str.ends_with("\r\n\r\n"));
+	REQUIRE(str.ends_with('\n'));
+	REQUIRE(str.contains("Host"));
+	REQUIRE(!str.contains('\t'));
+
+	REQUIRE(ptl::string{}.find("") == 0);
+	REQUIRE(!ptl::string{}.starts_with('a'));
+}
+
+TEST_CASE("string concatenation", "[string]") {
+	const ptl::string key{"a rather long key prefix"}, separator{"::"};
+	const std::string_view component{"component"};
+	const std::string id{"1234567890"};
+
+	//allocations are counted through a policy, which is used for every growth of the string
+	ptl::test::counting_policy counter;
+	ptl::string result{counter.policy};
+	const auto before{counter.allocations};
+	static_assert(!std::is_same_v<decltype(key + separator + component), ptl::string>); //operands are combined lazily => no temporary strings
+	result += key + separator + component + '/' + id + separator + "suffix" + '!';
+	REQUIRE(counter.allocations == before + 1); //N-way concatenation allocates exactly once
+	REQUIRE(result == "a rather long key prefix::component/1234567890::suffix!");
+	REQUIRE(ptl::string{key + separator + component} == "a rather long key prefix::component");
+	REQUIRE((key + separator).size() == key.size() + separator.size());
+
+	ptl::string appended{counter.policy};
+	appended += key;
+	appended.reserve(1'000);
+	const auto reserved{counter.allocations};
+	appended += separator + component + '/' + id;
+	REQUIRE(counter.allocations == reserved); //appending within capacity does not allocate
+	REQUIRE(appended == "a rather long key prefix::component/1234567890");
+
+	//operands may alias the target
+	ptl::string s{"abc"};
+	s = s + s + s;
+	REQUIRE(s == "abcabcabc");
+	s += s + '-' + s;
+	REQUIRE(s == "abcabcabcabcabcabc-abcabcabc");
+	s.reserve(1'000);
+	s += '+' + s;
+	REQUIRE(s == "abcabcabcabcabcabc-abcabcabc+abcabcabcabcabcabc-abcabcabc");
+
+	//rvalue strings are moved into the expression
+	const auto expr{ptl::string{"a temporary string exceeding SSO"} + ' ' + "value"};
+	REQUIRE(ptl::string{expr} == "a temporary string exceeding SSO value");
+	REQUIRE(expr == "a temporary string exceeding SSO value");
+	const auto owning{key + std::string(64, 'x')}; //any temporary owning its characters is moved as well
+	REQUIRE(ptl::string{owning} == "a rather long key prefix" + std::string(64, 'x'));
+
+	REQUIRE('<' + key + '>' == "<a rather long key prefix>");
+	REQUIRE("[" + key + "]" == "[a rather long key prefix]");
+	REQUIRE(component + key == "componenta rather long key prefix");
+}
+
+TEST_CASE("string number conversion", "[string]") {
+	ptl::string str;
+	str.append_integer(0);
+	str += ' ';
+	str.append_integer(-42);
+	str += ' ';
+	str.append_integer(std::numeric_limits<std::int64_t>::min());
+	str += ' ';
+	str.append_integer(std::numeric_limits<std::uint64_t>::max());
+	str += ' ';
+	str.append_integer(255u, 16);
+	str += ' ';
+	str.append_integer(std::numeric_limits<std::int64_t>::min(), 2);
+	REQUIRE(str == "0 -42 -9223372036854775808 18446744073709551615 ff -1000000000000000000000000000000000000000000000000000000000000000"s);
+
+	str.clear();
+	str.append_float(0.1);
+	str += ' ';
+	str.append_float(-2.2250738585072014e-308);
+	str += ' ';
+	str.append_float(1.5f);
+	str += ' ';
+	str.append_float(3.14159, std::chars_format::fixed, 2);
+	str += ' ';
+	str.append_float(1e300, std::chars_format::fixed, 3); //exceeds the initial estimate
+	char expected[512];
+	const auto last{std::to_chars(expected, expected + sizeof(expected), 1e300, std::chars_format::fixed, 3).ptr};
+	REQUIRE(str == "0.1 -2.2250738585072014e-308 1.5 3.14 "s + std::string(expected, last));
+
+	str.clear();
+	const std::vector<double> values{1.0, -0.5, 1e100, std::numeric_limits<double>::lowest(), std::numeric_limits<double>::denorm_min(), 0.0};
+	str.append_floats(values);
+	REQUIRE(str == "1,-0.5,1e+100,-1.7976931348623157e+308,5e-324,0"s);
+	str.append_floats(values, "; ");
+	REQUIRE(str == "1,-0.5,1e+100,-1.7976931348623157e+308,5e-324,01; -0.5; 1e+100; -1.7976931348623157e+308; 5e-324; 0"s);
+	str.clear();
+	str.append_floats({});
+	REQUIRE(str.empty());
+
+	//round trip
+	std::mt19937_64 engine{42};
+	for(auto i{0}; i < 1000; ++i) {
+		const auto bits{engine()};
+		double value;
+		std::memcpy(&value, &bits, sizeof(value));
+		if(std::isnan(value)) continue;
+		str.clear();
+		str.append_float(value);
+		double parsed{0};
+		REQUIRE(str.parse_float(parsed));
+		REQUIRE(parsed == value);
+
+		const auto integer{static_cast<std::int64_t>(bits)};
+		str.clear();
+		str.append_integer(integer, 36);
+		std::int64_t parsed_integer{0};
+		REQUIRE(str.parse_integer(parsed_integer, 36));
+		REQUIRE(parsed_integer == integer);
+	}
+}
@@ -0,0 +1,77 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_set>
+#include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/string_interner.hpp>
+
+TEST_CASE("string_interner intern", "[string_interner]") {
+	ptl::string_interner interner;
+	REQUIRE(interner.size() == 0);
+
+	std::string name{"metric.requests"};
+	const auto first{interner.intern(name)};
+	name[0] = 'M'; //interned strings are copies
+	const auto second{interner.intern(name)};
+	const auto third{interner.intern(std::string{"metric.requests"})};
+	REQUIRE(first == third);
+	REQUIRE(first != second);
+	REQUIRE(first.data() == third.data());
+	REQUIRE(std::string_view{first} == "metric.requests");
+	REQUIRE(std::string_view{second} == "Metric.requests");
+	REQUIRE(first.c_str()[first.size()] == 0);
+	REQUIRE(first.hash() == ptl::hash_bytes("metric.requests", 15));
+	REQUIRE(std::hash<ptl::interned_string>{}(first) == static_cast<std::size_t>(first.hash()));
+	REQUIRE(ptl::string_ref{first}.find('.') == 6);
+	REQUIRE(interner.size() == 2);
+
+	REQUIRE(interner.find("metric.requests") == first);
+	REQUIRE(interner.find("metric.latency").empty());
+	REQUIRE(interner.size() == 2);
+
+	const auto empty{interner.intern("")};
+	REQUIRE(empty == ptl::interned_string{});
+	REQUIRE(empty.empty());
+	REQUIRE(empty.size() == 0);
+	REQUIRE(empty.c_str()[0] == 0);
+	REQUIRE(empty.hash() == ptl::hash_bytes("", 0));
+	REQUIRE(interner.size() == 2);
+}
+
+TEST_CASE("string_interner growth", "[string_interner]") {
+	ptl::string_interner interner{3};
+	std::vector<ptl::interned_string> handles;
+	for(int i{0}; i < 10'000; ++i) handles.push_back(interner.intern("column_" + std::to_string(i)));
+	REQUIRE(interner.size() == 10'000);
+	REQUIRE(interner.memory_usage() >= 10'000 * (sizeof(std::uint64_t) + sizeof(std::size_t)));
+
+	for(int i{0}; i < 10'000; ++i) {
+		const auto name{"column_" + std::to_string(i)};
+		REQUIRE(interner.intern(name) == handles[static_cast<std::size_t>(i)]);
+		REQUIRE(std::string_view{handles[static_cast<std::size_t>(i)]} == name);
+	}
+	REQUIRE(interner.size() == 10'000);
+	REQUIRE(std::unordered_set<ptl::interned_string>(handles.begin(), handles.end()).size() == 10'000);
+}
+
+TEST_CASE("string_interner concurrency", "[string_interner]") {
+	constexpr int threads{8}, names{2'000};
+	ptl::string_interner interner;
+	std::vector<std::vector<ptl::interned_string>> handles(threads);
+	std::vector<std::thread> workers;
+	for(int t{0}; t < threads; ++t)
+		workers.emplace_back([&, t] {
+			for(int i{0}; i < names; ++i) handles[static_cast<std::size_t>(t)].push_back(interner.intern("name_" + std::to_string((i + t * 100) % names)));
+		});
+	for(auto & worker : workers) worker.join();
+
+	REQUIRE(interner.size() == names);
+	for(int t{0}; t < threads; ++t)
+		for(int i{0}; i < names; ++i) REQUIRE(handles[static_cast<std::size_t>(t)][static_cast<std::size_t>(i)] == interner.find("name_" + std::to_string((i + t * 100) % names)));
+}
@@ -4,6 +4,8 @@
 //    (See accompanying file ../LICENSE_1_0.txt or copy at
 //          http://www.boost.org/LICENSE_1_0.txt)
 
+#include <string>
+#include <vector>
 #include <sstream>
 #include <catch2/catch_all.hpp> //TODO: use more specific headers
 #include <ptl/string_ref.hpp>
@@ -70,3 +72,175 @@ TEST_CASE("string_ref substr", "[string_ref]") {
 	REQUIRE(substr1.size() == substr1.size());
 	for(std::size_t i{0}; i < substr1.size(); ++i) REQUIRE(subref1[i] == substr1[i]);
 }
+
+TEST_CASE("string_ref searching", "[string_ref]") {
+	static_assert("Hello World"_sr.find("World") == 6);
+	static_assert("Hello World"_sr.rfind('o') == 7);
+	static_assert("Hello World"_sr.find_first_of("xyzW") == 6);
+	static_assert("Hello World"_sr.find_last_not_of("dlr") == 7);
+	static_assert("Hello World"_sr.starts_with("Hello"));
+	static_assert("Hello World"_sr.ends_with('d'));
+	static_assert(!"Hello World"_sr.contains("world"));
+
+	//compare to std::string_view for all sizes and positions to cover every (partial) block of the SIMD kernels
+	std::string text;
+	for(std::size_t i{0}; i < 150; ++i) text += static_cast<char>('a' + i * 7 % 5);
+	const std::string_view needles[]{"", "a", "ab", "cab", "bcd", "abcde", "eabcdea", "xyz", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+	const std::string_view sets[]{"", "a", "ab", "ce", "abcd", "abcdefghijklmnopqrstuvwxyz"};
+	for(std::size_t size{0}; size <= text.size(); size += 1 + size / 10) {
+		const std::string_view sv{text.data(), size};
+		const ptl::string_ref ref{sv};
+		for(auto pos : {std::size_t{0}, std::size_t{1}, size / 2, size, size + 1, ptl::string_ref::npos}) {
+			for(const auto & needle : needles) {
+				REQUIRE(ref.find(needle, pos) == sv.find(needle, pos));
+				REQUIRE(ref.rfind(needle, pos) == sv.rfind(needle, pos));
+			}
+			for(const auto ch : {'a', 'c', 'e', 'x'}) {
+				REQUIRE(ref.find(ch, pos) == sv.find(ch, pos));
+				REQUIRE(ref.rfind(ch, pos) == sv.rfind(ch, pos));
+				REQUIRE(ref.find_first_not_of(ch, pos) == sv.find_first_not_of(ch, pos));
+				REQUIRE(ref.find_last_not_of(ch, pos) == sv.find_last_not_of(ch, pos));
+			}
+			for(const auto & set : sets) {
+				REQUIRE(ref.find_first_of(set, pos) == sv.find_first_of(set, pos));
+				REQUIRE(ref.find_last_of(set, pos) == sv.find_last_of(set, pos));
+				REQUIRE(ref.find_first_not_of(set, pos) == sv.find_first_not_of(set, pos));
+				REQUIRE(ref.find_last_not_of(set, pos) == sv.find_last_not_of(set, pos));
+			}
+		}
+	}
+
+	const std::string haystack(1'000, ' ');
+	for(std::size_t i{0}; i + 5 <= haystack.size(); i += 37) {
+		auto copy{haystack};
+		copy.replace(i, 5, "token");
+		const ptl::string_ref ref{copy};
+		REQUIRE(ref.find("token") == i);
+		REQUIRE(ref.rfind("token") == i);
+		REQUIRE(ref.find_first_not_of(' ') == i);
+		REQUIRE(ref.find_last_not_of(' ') == i + 4);
+		REQUIRE(ref.find_first_of("kot") == i);
+		REQUIRE(ref.contains("ken"));
+		REQUIRE(!ref.contains("tokens"));
+		REQUIRE(ref.starts_with("token") == (i == 0));
+	}
+
+	const ptl::string_ref empty;
+	REQUIRE(empty.find("") == 0);
+	REQUIRE(empty.rfind("") == 0);
+	REQUIRE(empty.find('a') == ptl::string_ref::npos);
+	REQUIRE(empty.find_last_of("abc") == ptl::string_ref::npos);
+	REQUIRE(empty.starts_with(""));
+	REQUIRE(!empty.ends_with('a'));
+}
+
+namespace {
+	template<typename Range>
+	auto collect(const Range & range) -> std::vector<std::string_view> {
+		std::vector<std::string_view> result;
+		for(const auto & piece : range) result.emplace_back(piece);
+		return result;
+	}
+
+	auto naive_split(std::string_view str, std::string_view delim) -> std::vector<std::string_view> {
+		std::vector<std::string_view> result;
+		for(std::size_t pos; (pos = str.find(delim)) != std::string_view::npos; str.remove_prefix(pos + delim.size())) result.push_back(str.substr(0, pos));
+		result.push_back(str);
+		return result;
+	}
+
+	auto naive_split_any(std::string_view str, std::string_view set) -> std::vector<std::string_view> {
+		std::vector<std::string_view> result;
+		for(std::size_t pos; (pos = str.find_first_of(set)) != std::string_view::npos; str.remove_prefix(pos + 1)) result.push_back(str.substr(0, pos));
+		result.push_back(str);
+		return result;
+	}
+
+	auto getlines(const std::string & str) -> std::vector<std::string> {
+		std::vector<std::string> result;
+		std::istringstream is{str};
+		for(std::string line; std::getline(is, line); ) {
+			if(!line.empty() && line.back() == '\r') line.pop_back();
+			result.push_back(line);
+		}
+		return result;
+	}
+}
+
+TEST_CASE("string_ref split", "[string_ref]") {
+	REQUIRE(collect(ptl::string_ref{"a,b,,c"}.split(',')) == std::vector<std::string_view>{"a", "b", "", "c"});
+	REQUIRE(collect(ptl::string_ref{",a,"}.split(',')) == std::vector<std::string_view>{"", "a", ""});
+	REQUIRE(collect(ptl::string_ref{}.split(',')) == std::vector<std::string_view>{""});
+	REQUIRE(collect(ptl::string_ref{"a::b:::c"}.split("::")) == std::vector<std::string_view>{"a", "b", ":c"});
+	REQUIRE(collect(ptl::string_ref{"abc"}.split("")) == std::vector<std::string_view>{"abc"});
+	REQUIRE(collect(ptl::string_ref{"key=value; other , x"}.split_any(";, ")) == std::vector<std::string_view>{"key=value", "", "other", "", "", "x"});
+	REQUIRE(collect(ptl::string_ref{"abc"}.split_any("")) == std::vector<std::string_view>{"abc"});
+	REQUIRE(collect(ptl::string_ref{"first\r\nsecond\n\nthird"}.lines()) == std::vector<std::string_view>{"first", "second", "", "third"});
+	REQUIRE(collect(ptl::string_ref{"line\n"}.lines()) == std::vector<std::string_view>{"line"});
+	REQUIRE(collect(ptl::string_ref{"\n"}.lines()) == std::vector<std::string_view>{""});
+	REQUIRE(collect(ptl::string_ref{"a\r"}.lines()) == std::vector<std::string_view>{"a\r"}); //not followed by a delimiter
+	REQUIRE(collect(ptl::string_ref{"a\r\nb\r"}.lines()) == std::vector<std::string_view>{"a", "b\r"});
+	REQUIRE(collect(ptl::string_ref{"a\r\n"}.lines()) == std::vector<std::string_view>{"a"});
+	REQUIRE(collect(ptl::string_ref{}.lines()).empty());
+
+	const auto range{ptl::string_ref{"x y"}.split(' ')};
+	auto it{range.begin()};
+	REQUIRE(*it++ == "x");
+	REQUIRE(it != range.end());
+	REQUIRE(*it == "y");
+	REQUIRE(++it == range.end());
+
+	//exercise the windowed scan with pieces spanning, straddling and filling entire windows
+	std::string str;
+	for(std::size_t i{0}; i < 2'000; ++i) str += static_cast<char>("ab,;\n\r"[(i * i + i / 7) % (i % 3 == 0 ? 2 : 6)]);
+	for(std::size_t size{0}; size <= str.size(); size = size * 2 + 1) {
+		const std::string_view sv{str.data(), size};
+		const ptl::string_ref ref{sv};
+		REQUIRE(collect(ref.split(',')) == naive_split(sv, ","));
+		REQUIRE(collect(ref.split(std::string_view{",;"})) == naive_split(sv, ",;"));
+		REQUIRE(collect(ref.split("aa")) == naive_split(sv, "aa"));
+		REQUIRE(collect(ref.split(std::string(70, 'a'))) == naive_split(sv, std::string(70, 'a')));
+		REQUIRE(collect(ref.split_any(",;")) == naive_split_any(sv, ",;"));
+		REQUIRE(collect(ref.split_any("abcdefghijklmnopqrstuvwxyz,")) == naive_split_any(sv, "abcdefghijklmnopqrstuvwxyz,"));
+
+		const auto lines{collect(ref.lines())};
+		const auto expected{getlines(std::string{sv})};
+		REQUIRE(std::vector<std::string>(lines.begin(), lines.end()) == expected);
+	}
+}
+
+TEST_CASE("string_ref parsing", "[string_ref]") {
+	int i{-1};
+	REQUIRE("123"_sr.parse_integer(i));
+	REQUIRE(i == 123);
+	REQUIRE("-7f"_sr.parse_integer(i, 16));
+	REQUIRE(i == -127);
+	REQUIRE_FALSE("12a"_sr.parse_integer(i));
+	REQUIRE_FALSE(""_sr.parse_integer(i));
+	REQUIRE_FALSE(" 1"_sr.parse_integer(i));
+	REQUIRE_FALSE("+1"_sr.parse_integer(i));
+	REQUIRE_FALSE("99999999999"_sr.parse_integer(i));
+	REQUIRE(i == -127);
+
+	unsigned char uc{0};
+	REQUIRE("255"_sr.parse_integer(uc));
+	REQUIRE(uc == 255);
+	REQUIRE_FALSE("256"_sr.parse_integer(uc));
+	REQUIRE_FALSE("-1"_sr.parse_integer(uc));
+
+	double d{-1};
+	REQUIRE("0.25"_sr.parse_float(d));
+	REQUIRE(d == 0.25);
+	REQUIRE("-1e-3"_sr.parse_float(d));
+	REQUIRE(d == -1e-3);
+	REQUIRE("ff.8p0"_sr.parse_float(d, std::chars_format::hex));
+	REQUIRE(d == 255.5);
+	REQUIRE_FALSE("1e5"_sr.parse_float(d, std::chars_format::fixed));
+	REQUIRE_FALSE("1.0x"_sr.parse_float(d));
+	REQUIRE_FALSE("1e999"_sr.parse_float(d));
+	REQUIRE(d == 255.5);
+
+	float f{0};
+	REQUIRE("1.5"_sr.parse_float(f));
+	REQUIRE(f == 1.5f);
+}
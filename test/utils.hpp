@@ -5,10 +5,31 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #pragma once
+#include <cstdlib>
 #include <iterator>
 #include <stdexcept>
+#include <ptl/allocation_policy.hpp>
 
 namespace ptl::test {
+	//implemented only in terms of the binary stable interface, as a policy provided by another compiler would be
+	struct counting_policy final {
+		allocation_policy policy{
+			+[](allocation_policy * self, std::size_t size) noexcept -> void * {
+				auto & counter{*reinterpret_cast<counting_policy *>(self)};
+				++counter.allocations;
+				counter.bytes += size;
+				return std::malloc(size);
+			},
+			+[](allocation_policy * self, void * ptr, std::size_t size) noexcept {
+				auto & counter{*reinterpret_cast<counting_policy *>(self)};
+				++counter.deallocations;
+				counter.bytes -= size;
+				std::free(ptr);
+			}
+		};
+		std::size_t allocations{0}, deallocations{0}, bytes{0};
+	};
+
 	struct moveable final {
 		bool moved{false};
 
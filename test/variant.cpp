@@ -34,6 +34,16 @@ TEST_CASE("variant ctor", "[variant]") {
 
 	var2.emplace<Y>(1, 2, 3);
 	REQUIRE(var2.holds<Y>());
+
+	struct Z {
+		Z() {}
+		Z(int) { throw 1; }
+	};
+	ptl::variant<int, Z> var3{5};
+	REQUIRE_THROWS(var3.emplace<Z>(0));
+	REQUIRE(var3.get<int>() == 5); //unchanged as Z is constructed first
+	var3 = var3.get<int>() + 1;
+	REQUIRE(var3.get<int>() == 6);
 }
 
 TEST_CASE("variant copy", "[variant]") {
@@ -229,3 +239,46 @@ TEST_CASE("variant comparison", "[variant]") {
 	REQUIRE(var1 > var4);
 	REQUIRE(var4 < var1);
 }
+
+namespace {
+	template<std::size_t I>
+	struct alternative final {
+		std::size_t value{I};
+
+		friend
+		auto operator==(const alternative & lhs, const alternative & rhs) noexcept -> bool { return lhs.value == rhs.value; }
+		friend
+		auto operator!=(const alternative & lhs, const alternative & rhs) noexcept -> bool { return lhs.value != rhs.value; }
+	};
+
+	//every alternative is visited, copied, compared and swapped through the same dispatch as the variant uses for its size (chain, switch or table)
+	template<std::size_t... Indices>
+	void test_alternatives(std::index_sequence<Indices...>) {
+		using variant = ptl::variant<alternative<Indices>...>;
+		const auto test{[](auto index) {
+			constexpr auto I{decltype(index)::value};
+			variant var{alternative<I>{}};
+			REQUIRE(var.template holds<alternative<I>>());
+			REQUIRE(var.visit([](const auto & value) { return value.value; }) == I);
+			REQUIRE(std::move(var).visit([](auto && value) -> std::size_t { return value.value * 2; }) == I * 2);
+
+			const auto copy{var};
+			REQUIRE(copy == var);
+			variant other{alternative<0>{}};
+			other.template emplace<alternative<I>>(alternative<I>{I + 1});
+			REQUIRE(copy != other);
+			swap(other, var);
+			REQUIRE(var.template get<alternative<I>>().value == I + 1);
+			REQUIRE(copy == other);
+		}};
+		(test(std::integral_constant<std::size_t, Indices>{}), ...);
+	}
+}
+
+TEST_CASE("variant alternatives", "[variant]") {
+	test_alternatives(std::make_index_sequence<1>{});
+	test_alternatives(std::make_index_sequence<8>{});
+	test_alternatives(std::make_index_sequence<6>{});
+	test_alternatives(std::make_index_sequence<16>{});
+	test_alternatives(std::make_index_sequence<20>{});
+}
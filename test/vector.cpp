@@ -5,11 +5,51 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #include <catch2/catch_all.hpp> //TODO: use more specific headers
+#include <ptl/string.hpp>
 #include <ptl/vector.hpp>
 #include "utils.hpp"
 
 //TODO: redesign unit tests for new implementations
 
+namespace {
+	struct counted final {
+		inline static std::size_t moves{0}, destructions{0};
+
+		int value{0};
+
+		counted() noexcept =default;
+		counted(int value) noexcept : value{value} {}
+		counted(const counted &) noexcept =default;
+		counted(counted && other) noexcept : value{other.value} { ++moves; }
+		auto operator=(const counted &) noexcept -> counted & =default;
+		auto operator=(counted &&) noexcept -> counted & =default;
+		~counted() noexcept { ++destructions; }
+
+		friend
+		void swap(counted & lhs, counted & rhs) noexcept { std::swap(lhs.value, rhs.value); }
+	};
+
+	struct relocatable final {
+		inline static std::size_t moves{0};
+
+		int value{0};
+
+		relocatable() noexcept =default;
+		relocatable(int value) noexcept : value{value} {}
+		relocatable(const relocatable &) noexcept =default;
+		relocatable(relocatable && other) noexcept : value{other.value} { ++moves; }
+		auto operator=(const relocatable &) noexcept -> relocatable & =default;
+		auto operator=(relocatable &&) noexcept -> relocatable & =default;
+		~relocatable() noexcept {}
+
+		friend
+		void swap(relocatable & lhs, relocatable & rhs) noexcept { std::swap(lhs.value, rhs.value); }
+	};
+}
+
+template<>
+struct ptl::is_trivially_relocatable<relocatable> : std::true_type {};
+
 TEST_CASE("vector ctor", "[vector]") {
 	using ptl::test::input_iterator;
 
@@ -70,6 +110,21 @@ TEST_CASE("vector swapping", "[vector]") {
 	}
 }
 
+TEST_CASE("vector push_back", "[vector]") {
+	ptl::vector<int> v;
+	for(auto i{0}; i < 1'000; ++i) {
+		REQUIRE(v.push_back(i) == i);
+		REQUIRE(v.back() == i);
+	}
+	REQUIRE(v.size() == 1'000);
+	for(auto i{0}; i < 1'000; ++i) REQUIRE(v[i] == i);
+
+	//pushing an element of the vector itself, both with and without reallocation
+	ptl::vector<int> v2{1};
+	while(v2.size() != 100) v2.push_back(v2.front());
+	REQUIRE(v2 == ptl::vector<int>(100, 1));
+}
+
 TEST_CASE("vector resize", "[vector]") {
 	ptl::vector<int> v{1, 2, 3, 4, 5, 6, 7, 8, 9};
 
@@ -92,6 +147,50 @@ TEST_CASE("vector resize", "[vector]") {
 	REQUIRE(v == ptl::vector{1, 2, 10, 10, 10});
 }
 
+TEST_CASE("vector resize capacity", "[vector]") {
+	ptl::vector<int> v;
+	v.reserve(1'000);
+	const auto data{v.data()};
+	const auto capacity{v.capacity()};
+	for(std::size_t i{1}; i <= capacity; ++i) {
+		v.resize(i, 1);
+		REQUIRE(v.data() == data);
+		REQUIRE(v.capacity() == capacity);
+	}
+	REQUIRE(v == ptl::vector<int>(capacity, 1));
+
+	//geometric growth => logarithmic number of reallocations
+	ptl::vector<int> v2;
+	std::size_t reallocations{0};
+	for(std::size_t i{1}; i <= 1'000'000; ++i) {
+		const auto old{v2.capacity()};
+		v2.resize(i);
+		if(v2.capacity() != old) ++reallocations;
+	}
+	REQUIRE(reallocations < 30);
+}
+
+TEST_CASE("vector resize_for_overwrite", "[vector]") {
+	ptl::vector<int> v{1, 2, 3};
+
+	v.resize_for_overwrite(1);
+	REQUIRE(v == ptl::vector{1});
+
+	v.resize_for_overwrite(1'000);
+	REQUIRE(v.size() == 1'000);
+	REQUIRE(v[0] == 1);
+	for(std::size_t i{1}; i < v.size(); ++i) v[i] = static_cast<int>(i);
+	for(std::size_t i{1}; i < v.size(); ++i) REQUIRE(v[i] == static_cast<int>(i));
+
+	struct non_trivial final {
+		int value{42};
+	};
+	ptl::vector<non_trivial> v2;
+	v2.resize_for_overwrite(100);
+	REQUIRE(v2.size() == 100);
+	for(const auto & e : v2) REQUIRE(e.value == 42);
+}
+
 TEST_CASE("vector clear", "[vector]") {
 	ptl::vector<int> v;
 	REQUIRE(v.empty());
@@ -160,3 +259,48 @@ TEST_CASE("vector assign", "[vector]") {
 	v.assign(4, 1);
 	REQUIRE(v == ptl::vector{1, 1, 1, 1});
 }
+
+TEST_CASE("vector relocation", "[vector]") {
+	static_assert(ptl::is_trivially_relocatable_v<int>);
+	static_assert(ptl::is_trivially_relocatable_v<ptl::string>);
+	static_assert(ptl::is_trivially_relocatable_v<ptl::vector<counted>>);
+	static_assert(!ptl::is_trivially_relocatable_v<counted>);
+
+	ptl::vector<relocatable> r;
+	for(int i{0}; i < 1'000; ++i) r.emplace_back(i);
+	r.reserve(5'000);
+	r.resize(10'000);
+	r.insert(r.begin() + 1, 1'000, relocatable{1});
+	r.shrink_to_fit();
+	REQUIRE(relocatable::moves == 0); //relocated by copying bytes
+	REQUIRE(r.size() == 11'000);
+	for(int i{0}; i < 1'000; ++i) REQUIRE(r[i == 0 ? 0 : i + 1'000].value == i);
+
+	counted::moves = counted::destructions = 0;
+	{
+		ptl::vector<counted> c;
+		for(int i{0}; i < 1'000; ++i) c.push_back(i);
+		REQUIRE(counted::moves > 0); //relocated by move construction
+		REQUIRE(counted::destructions == counted::moves);
+		for(int i{0}; i < 1'000; ++i) REQUIRE(c[i].value == i);
+	}
+	REQUIRE(counted::destructions == counted::moves + 1'000);
+
+	ptl::vector<ptl::string> s;
+	for(int i{0}; i < 1'000; ++i) s.push_back(ptl::string(static_cast<std::size_t>(i % 50), 'x'));
+	s.reserve(10'000);
+	for(int i{0}; i < 1'000; ++i) REQUIRE(s[i] == ptl::string(static_cast<std::size_t>(i % 50), 'x'));
+}
+
+TEST_CASE("vector growth aliasing", "[vector]") {
+	ptl::vector<int> v{1};
+	for(int i{0}; i < 1'000; ++i) v.push_back(v[0]);
+	REQUIRE(v == ptl::vector<int>(1'001, 1));
+
+	v.resize(100'000, v[1]);
+	REQUIRE(v == ptl::vector<int>(100'000, 1));
+
+	ptl::vector<ptl::string> s{ptl::string(100, 'x')};
+	for(int i{0}; i < 1'000; ++i) s.emplace_back(s.back());
+	REQUIRE(s == ptl::vector<ptl::string>(1'001, ptl::string(100, 'x')));
+}